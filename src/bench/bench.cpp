@@ -0,0 +1,239 @@
+//////////////////////////////////
+//
+// == A reuse distance based GPU cache model
+// This file is part of a cache model for GPUs. The cache model is based on
+// reuse distance theory extended to work with GPUs. The cache model primarly
+// focusses on modelling NVIDIA's Fermi architecture.
+//
+// == More information on the GPU cache model
+// Article............A Detailed GPU Cache Model Based on Reuse Distance Theory
+// Authors............C. Nugteren et al.
+//
+// == Contents of this file
+// This particular file implements microbenchmarks of the hot paths of the model:
+// the partial sum-hierarchy tree (B), the address to set mapping, the pool of
+// warps, the pool of outstanding requests and the coalescing in the scheduler.
+// The inputs are generated synthetically, so no trace is needed. Each benchmark
+// is repeated until it ran for a minimum time, after which the time per operation
+// and the throughput are reported. Build and run with 'make bench'.
+//
+// == File details
+// Filename...........src/bench/bench.cpp
+// Author.............Cedric Nugteren <www.cedricnugteren.nl>
+// Affiliation........Eindhoven University of Technology, The Netherlands
+// Last modified on...16-Oct-2026
+//
+//////////////////////////////////
+
+// Include the header file of the model
+#include "../model/model.h"
+
+// C++ headers
+#include <iomanip>
+#include <functional>
+
+//////////////////////////////////
+// Benchmark settings
+//////////////////////////////////
+#define BENCH_MIN_TIME 0.2      // Repeat each benchmark for at least this time (in seconds)
+#define BENCH_NUM_RANDOM 4096   // Number of pre-generated random numbers (a power of 2)
+
+// Sink for results, such that the compiler does not remove the benchmarked work
+volatile unsigned long sink = 0;
+
+//////////////////////////////////
+// Helper function to generate a list of pseudo-random numbers below a maximum
+//////////////////////////////////
+std::vector<unsigned> random_numbers(unsigned maximum) {
+	std::mt19937 gen(DEFAULT_SEED);
+	std::uniform_int_distribution<unsigned> distribution(0,maximum-1);
+	std::vector<unsigned> numbers(BENCH_NUM_RANDOM);
+	for (unsigned i=0; i<numbers.size(); i++) {
+		numbers[i] = distribution(gen);
+	}
+	return numbers;
+}
+
+//////////////////////////////////
+// Helper function to print the results of a benchmark
+//////////////////////////////////
+void report(const std::string name,
+            unsigned long num_ops,
+            double seconds) {
+	double ns_per_op = 1e9*seconds/num_ops;
+	std::cout << "### " << std::left << std::setw(40) << name << std::right << std::fixed
+	          << std::setprecision(2) << std::setw(12) << ns_per_op
+	          << std::setprecision(2) << std::setw(12) << num_ops/seconds/1e6 << std::endl;
+	std::cout.unsetf(std::ios::fixed);
+}
+
+//////////////////////////////////
+// Function to run a benchmark: a function performing a number of operations is
+// called repeatedly until the minimum time has passed. An optional set-up func-
+// tion is called before each repetition, outside of the measured time.
+//////////////////////////////////
+void benchmark(const std::string name,
+               unsigned long ops_per_call,
+               std::function<void()> function,
+               std::function<void()> setup = std::function<void()>()) {
+	unsigned long num_ops = 0;
+	double seconds = 0;
+	while (seconds < BENCH_MIN_TIME) {
+		if (setup) { setup(); }
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		function();
+		seconds += elapsed(start);
+		num_ops += ops_per_call;
+	}
+	report(name, num_ops, seconds);
+}
+
+//////////////////////////////////
+// Benchmarks of the tree: 'set' fills the tree, 'count' queries a filled tree at
+// random positions, and 'unset' empties the tree again
+//////////////////////////////////
+void benchmark_tree(unsigned size) {
+	std::string suffix = " (size "+std::to_string(size)+")";
+	std::vector<unsigned> targets = random_numbers(size);
+	Arena arena;
+	Tree tree(size,arena);
+	benchmark("Tree::set"+suffix, size, [&]() {
+		for (unsigned i=0; i<size; i++) { tree.set(i); }
+	}, [&]() {
+		for (unsigned i=0; i<size; i++) { tree.unset(i); }
+	});
+	for (unsigned i=0; i<size; i++) { tree.set(i); }
+	benchmark("Tree::count"+suffix, size, [&]() {
+		unsigned long total = 0;
+		for (unsigned i=0; i<size; i++) { total += tree.count(targets[i & (BENCH_NUM_RANDOM-1)]); }
+		sink += total;
+	});
+	benchmark("Tree::unset"+suffix, size, [&]() {
+		for (unsigned i=0; i<size; i++) { tree.unset(i); }
+	}, [&]() {
+		for (unsigned i=0; i<size; i++) { tree.set(i); }
+	});
+}
+
+//////////////////////////////////
+// Benchmarks of the address to set mapping for each of the mapping types
+//////////////////////////////////
+void benchmark_line_addr_to_set(const Settings hardware) {
+	const unsigned num_ops = 1024*1024;
+	const char* names[3] = { "modulo", "XOR", "Fermi" };
+	for (unsigned mapping_type=0; mapping_type<3; mapping_type++) {
+		benchmark(std::string("line_addr_to_set (")+names[mapping_type]+")", num_ops, [&]() {
+			unsigned long total = 0;
+			for (unsigned long i=0; i<num_ops; i++) {
+				unsigned long addr = i*hardware.line_size*7;
+				total += line_addr_to_set(addr/hardware.line_size,addr,hardware.cache_sets,hardware.cache_bytes,mapping_type);
+			}
+			sink += total;
+		});
+	}
+}
+
+//////////////////////////////////
+// Benchmark of the pool of warps for a given policy: warps are taken and returned,
+// a quarter of them with a (miss) delay, as in the model's loop
+//////////////////////////////////
+template <class Policy>
+void benchmark_pool(const std::string name,
+                    const Settings hardware) {
+	const unsigned num_warps = hardware.max_active_threads/hardware.warp_size;
+	const unsigned num_ops = 64*1024;
+	benchmark("Pool::take_warp/add_warp ("+name+")", num_ops, [&]() {
+		Pool<Policy> pool(hardware);
+		for (unsigned w=0; w<num_warps; w++) { pool.add_warp(w,0,false); }
+		pool.set_size();
+		unsigned long total = 0;
+		for (unsigned i=0; i<num_ops; i++) {
+			if (pool.has_work()) {
+				unsigned warp = pool.take_warp();
+				total += warp;
+				pool.add_warp(warp,(i%4 == 0) ? 3 : 0,(i%4 == 0));
+			}
+			pool.process_warps_in_flight();
+		}
+		sink += total;
+	});
+}
+
+//////////////////////////////////
+// Benchmark of the pool of outstanding requests: requests are added with future
+// times and taken out again when their time has come
+//////////////////////////////////
+void benchmark_requests(void) {
+	const unsigned num_ops = 64*1024;
+	std::vector<unsigned> latencies = random_numbers(200);
+	benchmark("Requests::add/get_requests", num_ops, [&]() {
+		Arena arena;
+		Requests requests(arena);
+		unsigned long total = 0;
+		for (unsigned timestamp=0; timestamp<num_ops; timestamp++) {
+			requests.add(timestamp*7, timestamp+latencies[timestamp & (BENCH_NUM_RANDOM-1)], 0);
+			total += requests.get_num_requests();
+			if (requests.has_requests(timestamp)) {
+				total += requests.get_requests(timestamp).size();
+			}
+		}
+		sink += total;
+	});
+}
+
+//////////////////////////////////
+// Benchmark of the coalescing in 'schedule_threads': each thread makes a number
+// of accesses, of which the accesses of a warp fall in a few cache-lines
+//////////////////////////////////
+void benchmark_schedule_threads(const Settings hardware) {
+	const unsigned num_threads = 16*1024;
+	const unsigned num_accesses = 16;
+	const unsigned blocksize = 256;
+	std::vector<Thread> pristine(num_threads);
+	for (unsigned tid=0; tid<num_threads; tid++) {
+		for (unsigned a=0; a<num_accesses; a++) {
+			unsigned long address = (unsigned long)a*num_threads*4 + tid*4;
+			pristine[tid].append_access(Access({0,address,1,4,address+3}));
+		}
+	}
+	std::vector<Thread> threads;
+	std::vector<std::vector<unsigned>> warps, blocks, cores;
+	benchmark("schedule_threads (per access)", (unsigned long)num_threads*num_accesses, [&]() {
+		schedule_threads(threads, warps, blocks, cores, hardware, blocksize);
+		sink += blocks.size();
+	}, [&]() {
+		threads = pristine;
+		warps.assign(num_threads/hardware.warp_size,std::vector<unsigned>());
+		blocks.assign(num_threads/blocksize,std::vector<unsigned>());
+		cores.assign(hardware.num_cores,std::vector<unsigned>());
+	});
+}
+
+//////////////////////////////////
+// Main function of the microbenchmarks
+//////////////////////////////////
+int main(int argc, char** argv) {
+	Settings hardware = default_settings();
+	finalise_settings(hardware);
+	
+	// Print the header of the results table
+	std::cout << SPLIT_STRING << std::endl;
+	std::cout << "### " << std::left << std::setw(40) << "Benchmark" << std::right
+	          << std::setw(12) << "ns/op" << std::setw(12) << "Mops/s" << std::endl;
+	std::cout << SPLIT_STRING << std::endl;
+	
+	// Run the benchmarks
+	benchmark_tree(1024);
+	benchmark_tree(64*1024);
+	benchmark_tree(1024*1024);
+	benchmark_line_addr_to_set(hardware);
+	benchmark_pool<PolicyLRR>("LRR", hardware);
+	benchmark_pool<PolicyGTO>("GTO", hardware);
+	benchmark_pool<PolicyTwoLevel>("two-level", hardware);
+	benchmark_requests();
+	benchmark_schedule_threads(hardware);
+	std::cout << SPLIT_STRING << std::endl;
+	return 0;
+}
+
+//////////////////////////////////
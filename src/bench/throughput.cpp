@@ -0,0 +1,109 @@
+//////////////////////////////////
+//
+// == A reuse distance based GPU cache model
+// This file is part of a cache model for GPUs. The cache model is based on
+// reuse distance theory extended to work with GPUs. The cache model primarly
+// focusses on modelling NVIDIA's Fermi architecture.
+//
+// == More information on the GPU cache model
+// Article............A Detailed GPU Cache Model Based on Reuse Distance Theory
+// Authors............C. Nugteren et al.
+//
+// == Contents of this file
+// This particular file implements an end-to-end throughput benchmark of the
+// model. Synthetic traces (see src/generator/generator.h) of growing sizes are
+// written for each access pattern, after which they are read and modelled as
+// usual. The number of accesses modelled per second is reported, both for the
+// model itself and including the reading of the trace. Build and run with 'make
+// throughput' (optionally with the maximum number of accesses per thread as ARGS).
+//
+// == File details
+// Filename...........src/bench/throughput.cpp
+// Author.............Cedric Nugteren <www.cedricnugteren.nl>
+// Affiliation........Eindhoven University of Technology, The Netherlands
+// Last modified on...16-Oct-2026
+//
+//////////////////////////////////
+
+// Include the header files of the model and the trace generator
+#include "../model/model.h"
+#include "../generator/generator.h"
+
+// C++ headers
+#include <iomanip>
+
+// System headers (to create the folder for the traces)
+#include <sys/stat.h>
+
+// Global settings for the directory structure (see src/model/io.cpp)
+extern std::string temp_dir;
+
+//////////////////////////////////
+// Benchmark settings
+//////////////////////////////////
+#define THROUGHPUT_MAX_ACCESSES 64 // Default maximum number of loads per thread
+#define THROUGHPUT_BLOCK 256       // Number of threads per threadblock
+
+//////////////////////////////////
+// Main function of the throughput benchmark
+//////////////////////////////////
+int main(int argc, char** argv) {
+	unsigned max_accesses = (argc >= 2) ? std::max(1,atoi(argv[1])) : THROUGHPUT_MAX_ACCESSES;
+	Settings hardware = default_settings();
+	finalise_settings(hardware);
+	Options options = default_options();
+	options.verbose = false;
+	mkdir(temp_dir.c_str(), 0755);
+	std::string filename = temp_dir+"/throughput.trc";
+	
+	// Print the header of the results table
+	std::cout << SPLIT_STRING << std::endl;
+	std::cout << "### " << std::left << std::setw(10) << "Pattern" << std::right << std::setw(8) << "Blocks"
+	          << std::setw(10) << "Loads" << std::setw(12) << "Trace MB" << std::setw(14) << "Model acc/s"
+	          << std::setw(14) << "Total acc/s" << std::endl;
+	std::cout << SPLIT_STRING << std::endl;
+	
+	// Grow the traces: first the number of threads, then the number of loads per thread
+	std::vector<std::pair<unsigned,unsigned>> sizes;
+	for (unsigned grid=4; grid*THROUGHPUT_BLOCK<=MAX_THREADS; grid*=4) {
+		sizes.push_back(std::make_pair(grid,std::min(16u,max_accesses)));
+	}
+	for (unsigned accesses=32; accesses<=max_accesses; accesses*=2) {
+		sizes.push_back(std::make_pair(sizes.back().first,accesses));
+	}
+	const char* patterns[5] = { "stream", "strided", "matmul", "stencil", "gather" };
+	for (unsigned p=0; p<5; p++) {
+		for (unsigned s=0; s<sizes.size(); s++) {
+			TraceParameters parameters = default_trace_parameters();
+			parameters.pattern = patterns[p];
+			parameters.grid = sizes[s].first;
+			parameters.block = THROUGHPUT_BLOCK;
+			parameters.accesses = sizes[s].second;
+			unsigned long num_loads = write_trace(parameters, filename);
+			std::ifstream trace_file(filename, std::ios::binary|std::ios::ate);
+			double trace_mb = trace_file.tellg()/(1024.0*1024.0);
+			
+			// Read and model the trace
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			Kernel kernel;
+			kernel.threads.resize(MAX_THREADS);
+			Dim3 blockdim = read_trace(kernel.threads, filename, options, hardware.write_policy != 0);
+			double read_time = elapsed(start);
+			prepare_kernel(kernel, blockdim, hardware);
+			run_model(kernel, hardware, options);
+			double total_time = elapsed(start);
+			
+			// Report the throughput
+			std::cout << "### " << std::left << std::setw(10) << patterns[p] << std::right << std::setw(8) << sizes[s].first
+			          << std::setw(10) << num_loads << std::fixed << std::setprecision(1) << std::setw(12) << trace_mb
+			          << std::setprecision(0) << std::setw(14) << num_loads/(total_time-read_time)
+			          << std::setw(14) << num_loads/total_time << std::endl;
+			std::cout.unsetf(std::ios::fixed);
+		}
+	}
+	std::remove(filename.c_str());
+	std::cout << SPLIT_STRING << std::endl;
+	return 0;
+}
+
+//////////////////////////////////
@@ -0,0 +1,80 @@
+//////////////////////////////////
+//
+// == A reuse distance based GPU cache model
+// This file is part of a cache model for GPUs. The cache model is based on
+// reuse distance theory extended to work with GPUs. The cache model primarly
+// focusses on modelling NVIDIA's Fermi architecture.
+//
+// == More information on the GPU cache model
+// Article............A Detailed GPU Cache Model Based on Reuse Distance Theory
+// Authors............C. Nugteren et al.
+//
+// == Contents of this file
+// This particular file is the main file of the trace generator. It writes a
+// synthetic trace (see src/generator/generator.h) for a benchmark name in the
+// output folder, such that it can be modelled as if it was produced by the
+// Ocelot tracer. The address ranges of the arrays are written as the buffer map
+// of the kernel.
+//
+// == File details
+// Filename...........src/generator/generator.cpp
+// Author.............Cedric Nugteren <www.cedricnugteren.nl>
+// Affiliation........Eindhoven University of Technology, The Netherlands
+// Last modified on...16-Oct-2026
+//
+//////////////////////////////////
+
+// Include the header file
+#include "generator.h"
+
+// System headers (to create the output folder)
+#include <sys/stat.h>
+
+// Global settings for the directory structure (see src/model/io.cpp)
+extern std::string output_dir;
+
+//////////////////////////////////
+// Main entry function of the trace generator
+//////////////////////////////////
+int main(int argc, char** argv) {
+	std::cout << SPLIT_STRING << std::endl;
+	message("");
+	
+	// Parse the input arguments: a benchmark name and a pattern followed by options
+	if (argc < 3) {
+		message("Error: provide a benchmark name and an access pattern");
+		message("Usage: generator <name> <stream|strided|matmul|stencil|gather> [--grid <n>] [--block <n>]");
+		message("       [--accesses <n>] [--bytes <n>] [--stride <n>] [--footprint <n>] [--seed <n>] [--type <0|2|3>]");
+		message("");
+		std::cout << SPLIT_STRING << std::endl;
+		exit(1);
+	}
+	std::string benchname = argv[1];
+	TraceParameters parameters = default_trace_parameters();
+	parameters.pattern = argv[2];
+	
+	// Write the trace as the first kernel of the benchmark
+	std::string kernelname = output_dir+"/"+benchname+"/"+benchname+"_00";
+	std::string filename = kernelname+".trc";
+	try {
+		parameters = get_trace_parameters(argc, argv, 3, parameters);
+		mkdir(output_dir.c_str(), 0755);
+		mkdir((output_dir+"/"+benchname).c_str(), 0755);
+		std::cout << "### Generating a '" << parameters.pattern << "' trace...";
+		unsigned long num_loads = write_trace(parameters, filename);
+		write_buffers(kernelname+".buffers");
+		std::cout << "done" << std::endl;
+		std::cout << "### Written " << num_loads << " loads to '" << filename << "'" << std::endl;
+	}
+	catch (std::exception &e) {
+		std::cout << std::endl << "### Error: " << e.what() << std::endl;
+		message("");
+		std::cout << SPLIT_STRING << std::endl;
+		exit(1);
+	}
+	message("");
+	std::cout << SPLIT_STRING << std::endl;
+	return 0;
+}
+
+//////////////////////////////////
@@ -0,0 +1,228 @@
+//////////////////////////////////
+//
+// == A reuse distance based GPU cache model
+// This file is part of a cache model for GPUs. The cache model is based on
+// reuse distance theory extended to work with GPUs. The cache model primarly
+// focusses on modelling NVIDIA's Fermi architecture.
+//
+// == More information on the GPU cache model
+// Article............A Detailed GPU Cache Model Based on Reuse Distance Theory
+// Authors............C. Nugteren et al.
+//
+// == Contents of this file
+// This particular file implements a generator of synthetic memory access traces
+// in the input format of the model (as produced by the Ocelot tracer): a line
+// with the blocksize, followed by lines with a thread identifier, a direction
+// (0 for a load, 1 for a store, 2 for a texture load and 3 for a constant load),
+// a byte address and the number of bytes. This
+// allows modelling without GPU-Ocelot and CUDA. The supported access patterns
+// are:
+// 1) stream: thread 'gid' loads element 'gid + i*T' in iteration 'i' (T threads)
+// 2) strided: as stream, but with a stride of 'stride' elements
+// 3) matmul: a tiled matrix-multiplication (C = A*B), one thread per element of C
+// 4) stencil: a 5-point 2D stencil, ping-ponging between two arrays
+// 5) gather: loads of random elements of an array of 'footprint' elements
+// The 2D patterns (matmul and stencil) use square threadblocks and a square grid
+// of threadblocks, rounded down from the given sizes. The loads of the first
+// array can be tagged as texture or constant loads (see 'load_type'). The address
+// ranges of the arrays can be written as a buffer map (see 'write_buffers').
+//
+// == File details
+// Filename...........src/generator/generator.h
+// Author.............Cedric Nugteren <www.cedricnugteren.nl>
+// Affiliation........Eindhoven University of Technology, The Netherlands
+// Last modified on...16-Oct-2026
+//
+//////////////////////////////////
+
+#ifndef GENERATOR_H
+#define GENERATOR_H
+
+// Include the header file of the model
+#include "../model/model.h"
+
+//////////////////////////////////
+// Generator settings
+//////////////////////////////////
+#define GENERATOR_BASE_A 0x10000000UL // Base address of the first array
+#define GENERATOR_BASE_B 0x50000000UL // Base address of the second array
+#define GENERATOR_BASE_C 0x90000000UL // Base address of the third array
+#define GENERATOR_ARRAY_BYTES 0x40000000UL // Size of the address range reserved for each array
+
+//////////////////////////////////
+// Data-structure holding the parameters of a synthetic trace
+//////////////////////////////////
+struct TraceParameters {
+	std::string pattern;          // The access pattern: stream, strided, matmul, stencil or gather
+	unsigned grid;                // Number of threadblocks
+	unsigned block;               // Number of threads per threadblock
+	unsigned accesses;            // Number of loads per thread
+	unsigned bytes;               // Size of each access in bytes (e.g. 4, 8 or 16)
+	unsigned stride;              // Stride in elements (strided only)
+	unsigned long footprint;      // Size of the array in elements (gather only)
+	unsigned long seed;           // Seed of the random addresses (gather only)
+	unsigned load_type;           // Type of the loads of the first array: 0 (global), 2 (texture) or 3 (constant)
+};
+
+//////////////////////////////////
+// Function to get the default parameters of a synthetic trace
+//////////////////////////////////
+inline TraceParameters default_trace_parameters(void) {
+	TraceParameters parameters = { "stream", 64, 256, 16, 4, 32, 1024*1024, DEFAULT_SEED, 0 };
+	return parameters;
+}
+
+//////////////////////////////////
+// Helper function to write a single access to a trace
+//////////////////////////////////
+inline void write_access(std::ostream &file,
+                         unsigned thread,
+                         unsigned direction,
+                         unsigned long address,
+                         unsigned bytes) {
+	file << thread << ' ' << direction << ' ' << address << ' ' << bytes << '\n';
+}
+
+//////////////////////////////////
+// Function to write a synthetic trace to a file. Returns the number of loads in
+// the trace, and throws a runtime error if the parameters are invalid.
+//////////////////////////////////
+inline unsigned long write_trace(const TraceParameters p,
+                                 const std::string filename) {
+	bool is_2d = (p.pattern == "matmul" || p.pattern == "stencil");
+	if (p.pattern != "stream" && p.pattern != "strided" && p.pattern != "gather" && !is_2d) {
+		throw std::runtime_error("unknown access pattern '"+p.pattern+"' (use stream, strided, matmul, stencil or gather)");
+	}
+	if (p.grid == 0 || p.block == 0 || p.accesses == 0 || p.bytes == 0 || p.stride == 0 || p.footprint == 0) {
+		throw std::runtime_error("the grid, block, access and element sizes should be non-zero");
+	}
+	if (p.load_type != 0 && p.load_type != ACCESS_TEXTURE && p.load_type != ACCESS_CONSTANT) {
+		throw std::runtime_error("the load type should be 0 (global), 2 (texture) or 3 (constant)");
+	}
+	
+	// Set the dimensions: square blocks and a square grid for the 2D patterns
+	unsigned tile = (unsigned)std::sqrt((double)p.block);
+	unsigned grid_dim = (unsigned)std::sqrt((double)p.grid);
+	Dim3 blockdim = (is_2d) ? Dim3({tile,tile,1}) : Dim3({p.block,1,1});
+	unsigned num_blocks = (is_2d) ? grid_dim*grid_dim : p.grid;
+	unsigned long num_threads = (unsigned long)num_blocks*blockdim.x*blockdim.y;
+	if (num_threads == 0 || num_threads > MAX_THREADS) {
+		throw std::runtime_error("the number of threads should be between 1 and "+std::to_string(MAX_THREADS));
+	}
+	unsigned size = grid_dim*tile;
+	
+	// Open the file and write the blocksize
+	std::ofstream file(filename);
+	if (!file) {
+		throw std::runtime_error("could not write trace file '"+filename+"'");
+	}
+	file << "blocksize: " << blockdim.x << " " << blockdim.y << " " << blockdim.z << '\n';
+	
+	// Write the accesses thread after thread
+	std::mt19937_64 gen(p.seed);
+	std::uniform_int_distribution<unsigned long> distribution(0,p.footprint-1);
+	unsigned long num_loads = 0;
+	for (unsigned gid=0; gid<num_threads; gid++) {
+	
+		// Compute the 2D position of the thread (2D patterns only)
+		unsigned bid = gid/(tile*tile);
+		unsigned row = (bid/std::max(1u,grid_dim))*tile + (gid%(tile*tile))/tile;
+		unsigned col = (bid%std::max(1u,grid_dim))*tile + (gid%(tile*tile))%tile;
+		
+		// Streaming, strided and random accesses
+		if (p.pattern == "stream" || p.pattern == "strided" || p.pattern == "gather") {
+			for (unsigned i=0; i<p.accesses; i++) {
+				unsigned long element = gid + (unsigned long)i*num_threads;
+				if (p.pattern == "strided") { element *= p.stride; }
+				if (p.pattern == "gather") {  element = distribution(gen); }
+				write_access(file, gid, p.load_type, GENERATOR_BASE_A + element*p.bytes, p.bytes);
+			}
+			num_loads += p.accesses;
+		}
+		
+		// Matrix-multiplication: a row of A times a column of B, then store to C
+		else if (p.pattern == "matmul") {
+			unsigned inner = std::max(1u,p.accesses/2);
+			for (unsigned k=0; k<inner; k++) {
+				write_access(file, gid, p.load_type, GENERATOR_BASE_A + ((unsigned long)row*inner + k)*p.bytes, p.bytes);
+				write_access(file, gid, 0, GENERATOR_BASE_B + ((unsigned long)k*size + col)*p.bytes, p.bytes);
+			}
+			write_access(file, gid, 1, GENERATOR_BASE_C + ((unsigned long)row*size + col)*p.bytes, p.bytes);
+			num_loads += 2*inner;
+		}
+		
+		// Stencil: load the centre and its 4 neighbours (clamped at the borders) and
+		// store the result, swapping the input and output arrays every iteration
+		else if (p.pattern == "stencil") {
+			unsigned iterations = std::max(1u,p.accesses/5);
+			int neighbours[5][2] = { {0,0}, {-1,0}, {1,0}, {0,-1}, {0,1} };
+			for (unsigned i=0; i<iterations; i++) {
+				unsigned long input = (i%2 == 0) ? GENERATOR_BASE_A : GENERATOR_BASE_B;
+				unsigned long output = (i%2 == 0) ? GENERATOR_BASE_B : GENERATOR_BASE_A;
+				unsigned type = (i%2 == 0) ? p.load_type : 0;
+				for (unsigned n=0; n<5; n++) {
+					int r = std::min(std::max((int)row+neighbours[n][0],0),(int)size-1);
+					int c = std::min(std::max((int)col+neighbours[n][1],0),(int)size-1);
+					write_access(file, gid, type, input + ((unsigned long)r*size + c)*p.bytes, p.bytes);
+				}
+				write_access(file, gid, 1, output + ((unsigned long)row*size + col)*p.bytes, p.bytes);
+			}
+			num_loads += 5*iterations;
+		}
+	}
+	file.close();
+	if (!file) {
+		throw std::runtime_error("could not write trace file '"+filename+"'");
+	}
+	return num_loads;
+}
+
+//////////////////////////////////
+// Function to write the address ranges of the arrays as a buffer map (in the
+// format of 'read_buffers'). Throws a runtime error if the file cannot be written.
+//////////////////////////////////
+inline void write_buffers(const std::string filename) {
+	std::ofstream file(filename);
+	file << std::hex;
+	file << "A 0x" << GENERATOR_BASE_A << " 0x" << GENERATOR_ARRAY_BYTES << '\n';
+	file << "B 0x" << GENERATOR_BASE_B << " 0x" << GENERATOR_ARRAY_BYTES << '\n';
+	file << "C 0x" << GENERATOR_BASE_C << " 0x" << GENERATOR_ARRAY_BYTES << '\n';
+	file.close();
+	if (!file) {
+		throw std::runtime_error("could not write buffer map '"+filename+"'");
+	}
+}
+
+//////////////////////////////////
+// Function to parse the parameters of a synthetic trace from the command-line
+// arguments, starting at a given index. Throws a runtime error on an invalid
+// argument.
+//////////////////////////////////
+inline TraceParameters get_trace_parameters(int argc,
+                                            char** argv,
+                                            int first,
+                                            TraceParameters parameters) {
+	for (int i=first; i<argc; i++) {
+		std::string argument = argv[i];
+		if (i+1 >= argc) {
+			throw std::runtime_error("missing value for argument '"+argument+"'");
+		}
+		std::string value = argv[++i];
+		if      (argument == "--grid") {      parameters.grid = atoi(value.c_str()); }
+		else if (argument == "--block") {     parameters.block = atoi(value.c_str()); }
+		else if (argument == "--accesses") {  parameters.accesses = atoi(value.c_str()); }
+		else if (argument == "--bytes") {     parameters.bytes = atoi(value.c_str()); }
+		else if (argument == "--stride") {    parameters.stride = atoi(value.c_str()); }
+		else if (argument == "--footprint") { parameters.footprint = strtoul(value.c_str(), 0, 10); }
+		else if (argument == "--seed") {      parameters.seed = strtoul(value.c_str(), 0, 10); }
+		else if (argument == "--type") {      parameters.load_type = atoi(value.c_str()); }
+		else {
+			throw std::runtime_error("unknown argument '"+argument+"'");
+		}
+	}
+	return parameters;
+}
+
+//////////////////////////////////
+
+#endif
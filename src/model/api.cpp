@@ -0,0 +1,537 @@
+//////////////////////////////////
+//
+// == A reuse distance based GPU cache model
+// This file is part of a cache model for GPUs. The cache model is based on
+// reuse distance theory extended to work with GPUs. The cache model primarly
+// focusses on modelling NVIDIA's Fermi architecture.
+//
+// == More information on the GPU cache model
+// Article............A Detailed GPU Cache Model Based on Reuse Distance Theory
+// Authors............C. Nugteren et al.
+//
+// == Contents of this file
+// This particular file implements the library API of the model, which allows
+// it to be embedded in other tools (e.g. an auto-tuner) without reading config-
+// uration files or writing output files. It provides functions to schedule a
+// kernel, to compute its reuse distance profile for the 4 cases (and for a
+// shared L2 cache and the texture and constant caches), and to derive the cache
+// miss breakdown from the profile. The command-line tool (see src/model/model.
+// cpp) is built on top of these functions.
+//
+// == File details
+// Filename...........src/model/api.cpp
+// Author.............Cedric Nugteren <www.cedricnugteren.nl>
+// Affiliation........Eindhoven University of Technology, The Netherlands
+// Last modified on...16-Oct-2026
+//
+//////////////////////////////////
+
+// Include the header file
+#include "model.h"
+
+//////////////////////////////////
+// Helper function to get the time in seconds since a given start time
+//////////////////////////////////
+double elapsed(std::chrono::steady_clock::time_point start) {
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+//////////////////////////////////
+// Function to assign the threads of a kernel to warps/blocks/cores and to
+// perform memory coalescing. This modifies the threads' accesses in-place.
+//////////////////////////////////
+void prepare_kernel(Kernel &kernel,
+                    const Dim3 blockdim,
+                    const Settings hardware) {
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	kernel.blocksize = blockdim.x*blockdim.y*blockdim.z;
+	unsigned num_blocks = ceil(kernel.threads.size()/(float)(kernel.blocksize));
+	unsigned num_warps_per_block = ceil(kernel.blocksize/(float)(hardware.warp_size));
+	kernel.warps.assign(num_warps_per_block*num_blocks,std::vector<unsigned>());
+	kernel.blocks.assign(num_blocks,std::vector<unsigned>());
+	kernel.cores.assign(hardware.num_cores,std::vector<unsigned>());
+	kernel.set_accesses.clear();
+	schedule_threads(kernel.threads, kernel.warps, kernel.blocks, kernel.cores, hardware, kernel.blocksize);
+	kernel.schedule_time = elapsed(start);
+}
+
+//////////////////////////////////
+// Function to compute the reuse distance profiles of a (prepared) kernel for
+// the 4 different cases and to derive the cache misses from them. If an L2 cache
+// is modelled, the L1 misses of all cores are collected as well, after which the
+// profile of the shared L2 cache is added as an extra histogram (see L2_CASE).
+// Texture and constant loads are modelled next to the L1 cache in their own
+// caches (if the kernel makes such loads), adding two more histograms.
+//////////////////////////////////
+Result run_model(Kernel &kernel,
+                 const Settings hardware,
+                 const Options options) {
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	std::ostream &out = *options.output;
+	Result result;
+	result.distances.resize((hardware.l2_bytes > 0) ? NUM_CASES+1 : NUM_CASES);
+	result.timings.schedule = kernel.schedule_time;
+	result.timings.l2 = 0;
+	result.writes = WriteStats({0,0,0,0,0,0});
+	result.sectors = SectorStats({0,0,0});
+	BandwidthMeter bandwidth(options.bandwidth_window);
+	
+	// Per-kernel arenas (one per worker) to allocate the model's data-structures from
+	std::vector<Arena> arenas(options.num_workers);
+	
+	// Model only a single core, modelling multiple cores requires a loop over 'cid'
+	// (the other cores are only modelled to obtain their misses for the L2 cache)
+	unsigned cid = 0;
+	std::vector<MissStream> l2_streams((hardware.l2_bytes > 0) ? hardware.num_cores : 0);
+	
+	// Count the accesses per set of the texture and constant caches, which are only modelled
+	// if the kernel makes such loads (the read-only caches always use the modulo mapping)
+	std::vector<ReadOnlyCache> read_only_caches;
+	const unsigned read_only_ids[2] = { CACHE_TEX, CACHE_CONST };
+	const unsigned read_only_sets[2] = { hardware.tex_sets, hardware.const_sets };
+	const unsigned read_only_ways[2] = { hardware.tex_ways, hardware.const_ways };
+	for (unsigned c=0; c<2; c++) {
+		if (read_only_sets[c] == 0) {
+			continue;
+		}
+		Geometry geometry = std::make_tuple(read_only_sets[c],read_only_ways[c],0u,read_only_ids[c]);
+		if (kernel.set_accesses.find(geometry) == kernel.set_accesses.end()) {
+			kernel.set_accesses[geometry] = count_set_accesses(kernel.threads, hardware, read_only_sets[c], read_only_ways[c], 0, read_only_ids[c], options);
+		}
+		const std::vector<unsigned> &counts = kernel.set_accesses[geometry];
+		if (std::accumulate(counts.begin(), counts.end(), 0u) > 0) {
+			read_only_caches.push_back(ReadOnlyCache({read_only_ids[c],read_only_sets[c],read_only_ways[c],&counts,0}));
+		}
+	}
+	if (read_only_caches.size() > 0) {
+		result.distances.resize(NUM_HISTOGRAMS);
+	}
+	std::vector<map_type<unsigned,unsigned>> read_only_scratch(read_only_caches.size());
+	
+	// Compute the number of active blocks on this core
+	unsigned hardware_max_active_blocks = std::min(hardware.max_active_threads/kernel.blocksize, hardware.max_active_blocks);
+	unsigned active_blocks = std::min((unsigned)kernel.cores[cid].size(), hardware_max_active_blocks);
+	result.active_blocks = active_blocks;
+	
+	// Start the computation of the reuse distance profile
+	if (options.verbose) {
+		message(out, "");
+		out << "### [core " << cid << "]:" << std::endl;
+		out << "### Running " << active_blocks << " block(s) at a time" << std::endl;
+		if (options.sample_rate < 1.0) {
+			out << "### Sampling " << 100*options.sample_rate << "% of the cache-lines" << std::endl;
+		}
+		if (options.num_workers > 1 && read_only_caches.size() > 0) {
+			out << "### Modelling serially: the set-parallel mode does not support texture and constant loads" << std::endl;
+		}
+		else if (options.num_workers > 1 && (options.slot_output || options.buffer_map)) {
+			out << "### Modelling serially: the set-parallel mode does not profile the slots or the buffers" << std::endl;
+		}
+		out << "### Calculating the reuse distances";
+	}
+	
+	// Prepare to model memory latencies: from a histogram or a half-normal distribution
+	unsigned long seed = options.seed;
+	std::vector<std::pair<unsigned,unsigned>> histogram;
+	if (options.latency_file != "") {
+		histogram = read_latency_histogram(options.latency_file);
+	}
+	
+	// Compute the reuse distance for 4 different cases
+	for (unsigned runs = 0; runs < NUM_CASES; runs++) {
+		std::chrono::steady_clock::time_point case_start = std::chrono::steady_clock::now();
+		if (options.verbose) { out << "..."; }
+		unsigned sets, ways;
+		unsigned ml, ms, nml;
+		unsigned mshr;
+		
+		// CASE 0 | Normal - full model
+		sets = hardware.cache_sets; ways = hardware.cache_ways;
+		ml = hardware.mem_latency; ms = hardware.mem_latency_stddev; nml = hardware.non_mem_latency;
+		mshr = hardware.num_mshr;
+		
+		// CASE 1 | Only 1 set: don't model associativity
+		if (runs == 1) {
+			sets = 1; ways = hardware.cache_ways*hardware.cache_sets;
+		}
+		
+		// CASE 2 | Memory latency to 0: don't model latencies
+		if (runs == 2) {
+			ml = 0; ms = 0; nml = 0;
+		}
+		
+		// CASE 3 | MSHR count to infinite: don't model MSHRs
+		if (runs == 3) {
+			mshr = INF;
+		}
+		
+		// Count the accesses per set (only once for each cache geometry)
+		Geometry geometry = std::make_tuple(sets,ways,hardware.mapping_type,(unsigned)CACHE_L1);
+		if (kernel.set_accesses.find(geometry) == kernel.set_accesses.end()) {
+			kernel.set_accesses[geometry] = count_set_accesses(kernel.threads, hardware, sets, ways, hardware.mapping_type, CACHE_L1, options);
+		}
+		
+		// The read-only caches are modelled in all cases (they influence the timing), but
+		// only the histograms of the normal case are kept
+		for (unsigned c=0; c<read_only_caches.size(); c++) {
+			read_only_caches[c].distances = (runs == 0) ? &result.distances[TEX_CASE+read_only_caches[c].id-CACHE_TEX] : &read_only_scratch[c];
+		}
+		
+		// Create the memory latencies: all cases use the same seed, such that they see
+		// the same sequence of latencies
+		LatencyProvider latencies = (histogram.size() > 0 && runs != 2) ? LatencyProvider(histogram,seed) : LatencyProvider(ml,ms,seed);
+		
+		// Calculate the reuse distance profile (in parallel over the sets if requested, but not
+		// with read-only caches, as their loads share the time with all sets, nor when profiling
+		// the slots or the buffers). The misses of the normal case are collected for the L2 cache,
+		// as are its write and sector traffic, its bandwidth demand and its histograms per slot
+		// and per buffer.
+		ModelOutputs outputs;
+		if (runs == 0) {
+			outputs.l2_stream = (l2_streams.size() > 0) ? &l2_streams[cid] : 0;
+			outputs.writes = &result.writes;
+			outputs.sectors = &result.sectors;
+			outputs.bandwidth = &bandwidth;
+			outputs.slots = (options.slot_output) ? &result.slots : 0;
+			outputs.buffer_map = options.buffer_map.get();
+			outputs.buffers = (options.buffer_map) ? &result.buffers : 0;
+		}
+		bool profiled = options.slot_output || options.buffer_map;
+		if (options.num_workers > 1 && sets > 1 && read_only_caches.size() == 0 && !profiled) {
+			reuse_distance_parallel(kernel.cores[cid], kernel.blocks, kernel.warps, kernel.threads, result.distances[runs],
+			                        kernel.set_accesses[geometry], active_blocks, hardware,
+			                        sets, ways, latencies, nml, options, arenas, outputs);
+		}
+		else {
+			reuse_distance(kernel.cores[cid], kernel.blocks, kernel.warps, kernel.threads, result.distances[runs],
+			               kernel.set_accesses[geometry], active_blocks, hardware,
+			               sets, ways, latencies, nml, mshr, options, arenas[0], outputs, read_only_caches);
+		}
+		
+		// Release all the data-structures of this case in one shot
+		for (unsigned w=0; w<arenas.size(); w++) {
+			arenas[w].reset();
+		}
+		result.timings.cases[runs] = elapsed(case_start);
+	}
+	
+	// Model the shared L2 cache: collect the misses of the other cores (normal case only,
+	// each core with its own seed) and compute the reuse distances of the merged streams.
+	// The seeds of the cores are drawn from the run's seed (as for the sets in the set-
+	// parallel mode), such that the runs of different seeds share no core's latencies.
+	if (l2_streams.size() > 0) {
+		std::chrono::steady_clock::time_point l2_start = std::chrono::steady_clock::now();
+		if (options.verbose) { out << "..."; }
+		Geometry geometry = std::make_tuple(hardware.cache_sets,hardware.cache_ways,hardware.mapping_type,(unsigned)CACHE_L1);
+		for (unsigned c=0; c<read_only_caches.size(); c++) {
+			read_only_caches[c].distances = &read_only_scratch[c];
+		}
+		LatencyProvider core_seeds(hardware.mem_latency,hardware.mem_latency_stddev,seed);
+		for (unsigned core=1; core<hardware.num_cores; core++) {
+			unsigned long core_seed = core_seeds.next_random();
+			if (kernel.cores[core].size() == 0) {
+				continue;
+			}
+			unsigned core_active_blocks = std::min((unsigned)kernel.cores[core].size(), hardware_max_active_blocks);
+			LatencyProvider latencies = (histogram.size() > 0) ? LatencyProvider(histogram,core_seed) :
+			                            LatencyProvider(hardware.mem_latency,hardware.mem_latency_stddev,core_seed);
+			map_type<unsigned,unsigned> core_distances;
+			ModelOutputs outputs;
+			outputs.l2_stream = &l2_streams[core];
+			if (options.num_workers > 1 && hardware.cache_sets > 1 && read_only_caches.size() == 0) {
+				reuse_distance_parallel(kernel.cores[core], kernel.blocks, kernel.warps, kernel.threads, core_distances,
+				                        kernel.set_accesses[geometry], core_active_blocks, hardware, hardware.cache_sets,
+				                        hardware.cache_ways, latencies, hardware.non_mem_latency, options, arenas, outputs);
+			}
+			else {
+				reuse_distance(kernel.cores[core], kernel.blocks, kernel.warps, kernel.threads, core_distances,
+				               kernel.set_accesses[geometry], core_active_blocks, hardware, hardware.cache_sets,
+				               hardware.cache_ways, latencies, hardware.non_mem_latency, hardware.num_mshr, options, arenas[0], outputs, read_only_caches);
+			}
+			for (unsigned w=0; w<arenas.size(); w++) {
+				arenas[w].reset();
+			}
+		}
+		l2_reuse_distance(l2_streams, result.distances[L2_CASE], hardware, options, arenas[0]);
+		arenas[0].reset();
+		result.timings.l2 = elapsed(l2_start);
+	}
+	if (options.verbose) { out << "done" << std::endl; }
+	
+	// Process the reuse distance profile to obtain the cache hit/miss rate
+	result.misses = compute_misses(result.distances, hardware, options);
+	result.bandwidth = bandwidth.finish(options.sample_rate);
+	result.timings.total = kernel.schedule_time + elapsed(start);
+	return result;
+}
+
+//////////////////////////////////
+// Function to compute the results of a (prepared) kernel for multiple seeds in
+// parallel (see 'num_seeds' in the options). Returns the results of the first
+// seed, together with the miss rates of all seeds.
+//////////////////////////////////
+Result run_model_seeds(Kernel &kernel,
+                       const Settings hardware,
+                       const Options options) {
+	if (options.num_seeds <= 1) {
+		return run_model(kernel, hardware, options);
+	}
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	if (options.verbose) {
+		message(*options.output, "");
+		*options.output << "### Modelling " << options.num_seeds << " seeds (" << options.seed << " to " << options.seed+options.num_seeds-1 << ")...";
+	}
+	
+	// The model modifies the state of the threads while running, so each worker
+	// (except the first) models on its own copy of the kernel
+	unsigned num_workers = options.num_jobs;
+	if (num_workers == 0) { num_workers = std::max(1u,std::thread::hardware_concurrency()); }
+	num_workers = std::min(num_workers, options.num_seeds);
+	std::vector<Kernel> copies(num_workers);
+	for (unsigned w=1; w<num_workers; w++) {
+		copies[w] = kernel;
+	}
+	std::vector<Result> results(options.num_seeds);
+	JobPool pool(num_workers);
+	pool.run(options.num_seeds, [&](unsigned w, unsigned s) {
+		Options seed_options = options;
+		seed_options.seed = options.seed + s;
+		seed_options.verbose = false;
+		results[s] = run_model((w == 0) ? kernel : copies[w], hardware, seed_options);
+	});
+	if (options.verbose) { *options.output << "done" << std::endl; }
+	
+	// Collect the miss rates of all seeds
+	Result result = results[0];
+	for (unsigned s=0; s<options.num_seeds; s++) {
+		result.miss_rates.push_back(results[s].misses.miss_rate);
+	}
+	result.timings.total = kernel.schedule_time + elapsed(start);
+	return result;
+}
+
+//////////////////////////////////
+// Function to model a kernel given as an in-memory list of threads and their
+// accesses (a copy is made, such that the input can be re-used)
+//////////////////////////////////
+Result model_accesses(const std::vector<Thread> &threads,
+                      const Dim3 blockdim,
+                      const Settings hardware,
+                      const Options options) {
+	Kernel kernel;
+	kernel.threads = threads;
+	prepare_kernel(kernel, blockdim, hardware);
+	return run_model(kernel, hardware, options);
+}
+
+//////////////////////////////////
+// Function to model a kernel given as a trace file (in the tracer's format)
+//////////////////////////////////
+Result model_trace(const std::string filename,
+                   const Settings hardware,
+                   const Options options) {
+	Kernel kernel;
+	kernel.threads.resize(MAX_THREADS);
+	Options quiet_options = options;
+	quiet_options.verbose = false;
+	Dim3 blockdim = read_trace(kernel.threads, filename, quiet_options, hardware.write_policy != 0);
+	if (blockdim.x*blockdim.y*blockdim.z == 0) {
+		throw std::runtime_error("could not read trace file '"+filename+"'");
+	}
+	prepare_kernel(kernel, blockdim, hardware);
+	return run_model(kernel, hardware, options);
+}
+
+//////////////////////////////////
+// Function to compute the cache misses (and their causes) from the reuse
+// distance profiles of the 4 different cases (and the L2 hits and misses)
+//////////////////////////////////
+Misses compute_misses(std::vector<map_type<unsigned,unsigned>> &distances,
+                      const Settings hardware,
+                      const Options options) {
+	unsigned miss_compulsory[NUM_CASES] = {0, 0, 0, 0};
+	unsigned miss_capacity[NUM_CASES] = {0, 0, 0, 0};
+	unsigned miss[NUM_CASES];
+	unsigned hits = 0;
+	
+	// Compute the cache misses for the 4 different cases
+	for (int i=0; i<NUM_CASES; i++) {
+		for(map_type<unsigned,unsigned>::iterator it=distances[i].begin(); it!= distances[i].end(); it++) {
+			unsigned cache_ways = hardware.cache_ways;
+			if (i == 1) { cache_ways = hardware.cache_ways*hardware.cache_sets; }
+			
+			// Compute the compulsory and capacity misses
+			if (it->first == INF) {
+				miss_compulsory[i] += it->second;
+			}
+			else if (it->first > cache_ways ) {
+				miss_capacity[i] += it->second;
+			}
+			
+			// Compute the hits
+			else if (i == 0) {
+				hits += it->second;
+			}
+		}
+		miss[i] = miss_compulsory[i] + miss_capacity[i];
+	}
+	
+	// Compute the various types of cache miss rates
+	int miss_associativity = miss[0] - miss[1];
+	int miss_latency       = miss_compulsory[0] - miss_compulsory[2];
+	int miss_mshr          = miss[0] - miss[3];
+	miss_compulsory[0] = miss_compulsory[2];
+	int rest = miss[0] - (miss_compulsory[0] + std::max(0,miss_latency) + std::max(0,miss_associativity) + std::max(0,miss_mshr));
+	miss_capacity[0] = std::max(0,rest);
+	if (rest < 0) {
+		if (miss_mshr > -rest) {         miss_mshr          = miss_mshr          - rest; }
+		else if (miss_latency > -rest) { miss_latency       = miss_latency       - rest; }
+		else {                           miss_associativity = miss_associativity - rest; }
+	}
+	
+	// Store the final cache misses and miss rates
+	Misses misses;
+	misses.compulsory = miss_compulsory[0];
+	misses.capacity = miss_capacity[0];
+	misses.associativity = std::max(0,miss_associativity);
+	misses.latency = std::max(0,miss_latency);
+	misses.mshr = std::max(0,miss_mshr);
+	misses.total = miss[0];
+	misses.total_associativity = miss[1];
+	misses.total_latency = miss[2];
+	misses.total_mshr = miss[3];
+	misses.hits = hits;
+	misses.accesses = misses.total + hits;
+	misses.miss_rate = 100*misses.total/(float)(misses.accesses);
+	
+	// Compute the hits and misses of the L2 cache (if modelled)
+	misses.l2_accesses = 0;
+	misses.l2_misses = 0;
+	if (distances.size() > L2_CASE) {
+		count_misses(distances[L2_CASE], hardware.l2_ways, misses.l2_accesses, misses.l2_misses);
+	}
+	misses.l2_hits = misses.l2_accesses - misses.l2_misses;
+	misses.l2_miss_rate = (misses.l2_accesses > 0) ? 100*misses.l2_misses/(float)(misses.l2_accesses) : 0;
+	
+	// Compute the misses of the texture and constant caches (if modelled)
+	misses.tex_accesses = 0;
+	misses.tex_misses = 0;
+	misses.const_accesses = 0;
+	misses.const_misses = 0;
+	if (distances.size() > CONST_CASE) {
+		count_misses(distances[TEX_CASE], hardware.tex_ways, misses.tex_accesses, misses.tex_misses);
+		count_misses(distances[CONST_CASE], hardware.const_ways, misses.const_accesses, misses.const_misses);
+	}
+	misses.tex_miss_rate = (misses.tex_accesses > 0) ? 100*misses.tex_misses/(float)(misses.tex_accesses) : 0;
+	misses.const_miss_rate = (misses.const_accesses > 0) ? 100*misses.const_misses/(float)(misses.const_accesses) : 0;
+	
+	// Estimate the error when sampling: the sampled cache-lines (counted as compulsory misses) are the
+	// independent samples, which gives a conservative 95% confidence bound on the miss rate
+	misses.error_bound = 0;
+	if (options.sample_rate < 1.0) {
+		double sampled_lines = std::max(1.0,miss_compulsory[2]*options.sample_rate);
+		double p = misses.miss_rate/100.0;
+		misses.error_bound = 100*1.96*sqrt(p*(1-p)/sampled_lines);
+	}
+	return misses;
+}
+
+//////////////////////////////////
+// Function to compute the bandwidth demand of the misses in bytes per cycle, on
+// average over the modelled time and at the peak (the busiest time window)
+//////////////////////////////////
+double average_bandwidth(const BandwidthStats &bandwidth) {
+	return (bandwidth.cycles > 0) ? bandwidth.bytes/(double)bandwidth.cycles : 0;
+}
+double peak_bandwidth(const BandwidthStats &bandwidth) {
+	return bandwidth.peak_bytes/(double)bandwidth.window;
+}
+
+//////////////////////////////////
+// Function to compute the total number of bytes moved to and from DRAM: the L2
+// misses if an L2 cache is modelled (otherwise all L1 miss requests), plus the
+// write traffic
+//////////////////////////////////
+unsigned long dram_bytes(const Result &result,
+                         const Settings hardware) {
+	unsigned long read_bytes = (hardware.l2_bytes > 0) ? (unsigned long)result.misses.l2_misses*hardware.line_size : result.bandwidth.bytes;
+	return read_bytes + result.writes.write_bytes;
+}
+
+//////////////////////////////////
+// Helper function to count the accesses and the misses of a reuse distance
+// histogram of a cache with a given associativity (as the normal case above)
+//////////////////////////////////
+void count_misses(const map_type<unsigned,unsigned> &histogram,
+                  unsigned cache_ways,
+                  unsigned &accesses,
+                  unsigned &misses) {
+	for(map_type<unsigned,unsigned>::const_iterator it=histogram.begin(); it!= histogram.end(); it++) {
+		accesses += it->second;
+		if (it->first == INF || it->first > cache_ways) { misses += it->second; }
+	}
+}
+
+//////////////////////////////////
+// Function to compute the accesses and the misses of each index of a profile (and
+// cache), e.g. of each instruction slot or buffer, sorted by index. An access
+// misses if its distance exceeds the associativity of its cache, as in
+// 'compute_misses'.
+//////////////////////////////////
+std::vector<ProfileStats> profile_statistics(const AccessProfile &profile,
+                                             const Settings hardware) {
+	unsigned ways[3] = { hardware.cache_ways, hardware.tex_ways, hardware.const_ways };
+	std::vector<ProfileStats> statistics;
+	std::vector<std::pair<unsigned long,unsigned>> entries = profile.sorted();
+	for (unsigned e=0; e<entries.size(); e++) {
+		unsigned index = AccessProfile::get_index(entries[e].first);
+		unsigned cache = AccessProfile::get_cache(entries[e].first);
+		unsigned distance = AccessProfile::get_distance(entries[e].first);
+		if (statistics.empty() || statistics.back().index != index || statistics.back().cache != cache) {
+			statistics.push_back(ProfileStats({index,cache,0,0}));
+		}
+		statistics.back().accesses += entries[e].second;
+		if (distance == INF || distance > ways[cache]) { statistics.back().misses += entries[e].second; }
+	}
+	return statistics;
+}
+
+//////////////////////////////////
+// Function to compute the miss-ratio curve of a reuse distance histogram: the miss
+// rate (in percentages) for every capacity from 1 up to and including the largest
+// finite reuse distance (beyond which only compulsory misses remain). Element 'c'
+// holds the miss rate with a capacity of 'c+1'. An access misses if its distance
+// exceeds the capacity, as in 'compute_misses'. The curve is computed in a single
+// pass over the sorted histogram.
+//////////////////////////////////
+std::vector<float> miss_ratio_curve(const map_type<unsigned,unsigned> &histogram) {
+	std::vector<std::pair<unsigned,unsigned>> entries(histogram.begin(), histogram.end());
+	std::sort(entries.begin(), entries.end());
+	
+	// Count the accesses and find the largest finite reuse distance
+	double accesses = 0;
+	unsigned max_distance = 0;
+	for (unsigned e=0; e<entries.size(); e++) {
+		accesses += entries[e].second;
+		if (entries[e].first != INF) { max_distance = entries[e].first; }
+	}
+	if (accesses == 0) {
+		return std::vector<float>();
+	}
+	
+	// Walk over the capacities and the sorted distances at the same time: all distances
+	// up to the current capacity are hits
+	std::vector<float> curve(std::max(1u,max_distance));
+	double hits = 0;
+	unsigned e = 0;
+	for (unsigned capacity=1; capacity<=curve.size(); capacity++) {
+		while (e < entries.size() && entries[e].first <= capacity && entries[e].first != INF) {
+			hits += entries[e].second;
+			e++;
+		}
+		curve[capacity-1] = 100*(accesses-hits)/accesses;
+	}
+	return curve;
+}
+
+//////////////////////////////////
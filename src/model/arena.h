@@ -0,0 +1,182 @@
+//////////////////////////////////
+//
+// == A reuse distance based GPU cache model
+// This file is part of a cache model for GPUs. The cache model is based on
+// reuse distance theory extended to work with GPUs. The cache model primarly
+// focusses on modelling NVIDIA's Fermi architecture.
+//
+// == More information on the GPU cache model
+// Article............A Detailed GPU Cache Model Based on Reuse Distance Theory
+// Authors............C. Nugteren et al.
+//
+// == Contents of this file
+// This particular file implements an arena (pool) allocator for the model's
+// data-structures. All tree nodes, hash-map nodes and request lists of a kernel
+// are allocated from large chunks, and released in one shot when the arena is
+// reset. Freed small blocks are kept in per-size free-lists for re-use, such
+// that short-lived nodes (e.g. requests) do not make the arena grow. The file
+// also provides an STL-compatible allocator to use the arena with containers.
+// An arena is not thread-safe: each worker thread should use its own arena.
+//
+// == File details
+// Filename...........src/model/arena.h
+// Author.............Cedric Nugteren <www.cedricnugteren.nl>
+// Affiliation........Eindhoven University of Technology, The Netherlands
+// Last modified on...16-Oct-2026
+//
+//////////////////////////////////
+
+#ifndef ARENA_H
+#define ARENA_H
+
+// C++ headers
+#include <vector>
+#include <new>
+#include <cstdlib>
+#include <cstddef>
+#include <utility>
+
+//////////////////////////////////
+// Arena settings
+//////////////////////////////////
+#define ARENA_CHUNK_SIZE (1024*1024) // Size of a chunk of memory (in bytes)
+#define ARENA_ALIGNMENT 16           // Alignment and granularity of allocations (in bytes)
+#define ARENA_NUM_CLASSES 32         // Number of free-lists (sizes up to 512 bytes are re-used)
+
+//////////////////////////////////
+// The arena allocator
+//////////////////////////////////
+class Arena {
+	std::vector<char*> chunks;    // Chunks of memory owned by the arena
+	unsigned current;             // Index of the chunk currently in use
+	size_t offset;                // Offset of the next free byte in the current chunk
+	void* free_lists[ARENA_NUM_CLASSES]; // Singly-linked lists of freed blocks (per size)
+	
+	// Disable copying: the arena owns its chunks
+	Arena(const Arena&);
+	Arena& operator=(const Arena&);
+
+public:
+
+	// Initialise an empty arena (chunks are only allocated when needed)
+	Arena() {
+		current = 0;
+		offset = 0;
+		for (unsigned c=0; c<ARENA_NUM_CLASSES; c++) { free_lists[c] = 0; }
+	}
+	
+	// Delete the arena and all its chunks
+	~Arena() {
+		for (unsigned c=0; c<chunks.size(); c++) { std::free(chunks[c]); }
+	}
+	
+	// Allocate a block of memory: from a free-list, from the current chunk, or
+	// directly from the system for blocks larger than a quarter of a chunk
+	void* allocate(size_t bytes) {
+		size_t size = (bytes + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+		if (size == 0) { size = ARENA_ALIGNMENT; }
+		size_t size_class = size/ARENA_ALIGNMENT - 1;
+		if (size_class < ARENA_NUM_CLASSES && free_lists[size_class] != 0) {
+			void* block = free_lists[size_class];
+			free_lists[size_class] = *static_cast<void**>(block);
+			return block;
+		}
+		if (size > ARENA_CHUNK_SIZE/4) {
+			void* block = std::malloc(size);
+			if (block == 0) { throw std::bad_alloc(); }
+			return block;
+		}
+		if (chunks.size() == 0 || offset + size > ARENA_CHUNK_SIZE) {
+			if (chunks.size() != 0) { current++; }
+			if (current == chunks.size()) {
+				char* chunk = static_cast<char*>(std::malloc(ARENA_CHUNK_SIZE));
+				if (chunk == 0) { throw std::bad_alloc(); }
+				chunks.push_back(chunk);
+			}
+			offset = 0;
+		}
+		void* block = chunks[current] + offset;
+		offset += size;
+		return block;
+	}
+	
+	// Return a block of memory: small blocks are kept for re-use, large blocks are
+	// returned to the system, other blocks are released when the arena is reset
+	void deallocate(void* block, size_t bytes) {
+		size_t size = (bytes + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+		if (size == 0) { size = ARENA_ALIGNMENT; }
+		size_t size_class = size/ARENA_ALIGNMENT - 1;
+		if (size_class < ARENA_NUM_CLASSES) {
+			*static_cast<void**>(block) = free_lists[size_class];
+			free_lists[size_class] = block;
+		}
+		else if (size > ARENA_CHUNK_SIZE/4) {
+			std::free(block);
+		}
+	}
+	
+	// Release all allocations in one shot (the chunks are kept for re-use)
+	void reset() {
+		current = 0;
+		offset = 0;
+		for (unsigned c=0; c<ARENA_NUM_CLASSES; c++) { free_lists[c] = 0; }
+	}
+	
+	// Find out how many bytes are reserved by the arena
+	size_t get_reserved() {
+		return chunks.size()*(size_t)ARENA_CHUNK_SIZE;
+	}
+};
+
+//////////////////////////////////
+// STL-compatible allocator using an arena
+//////////////////////////////////
+template <class T>
+class ArenaAllocator {
+public:
+	typedef T value_type;
+	typedef T* pointer;
+	typedef const T* const_pointer;
+	typedef T& reference;
+	typedef const T& const_reference;
+	typedef size_t size_type;
+	typedef ptrdiff_t difference_type;
+	template <class U> struct rebind { typedef ArenaAllocator<U> other; };
+	
+	Arena* arena;                 // The arena to allocate from
+	
+	// Initialise the allocator with an arena (or from an allocator of another type)
+	ArenaAllocator(Arena &_arena) : arena(&_arena) { }
+	template <class U> ArenaAllocator(const ArenaAllocator<U> &other) : arena(other.arena) { }
+	
+	// Allocate and deallocate memory for 'n' objects
+	T* allocate(size_t n, const void* = 0) {
+		return static_cast<T*>(arena->allocate(n*sizeof(T)));
+	}
+	void deallocate(T* block, size_t n) {
+		arena->deallocate(block, n*sizeof(T));
+	}
+	
+	// Construct and destroy objects in allocated memory
+	template <class U, class... Args> void construct(U* block, Args&&... args) {
+		::new((void*)block) U(std::forward<Args>(args)...);
+	}
+	template <class U> void destroy(U* block) {
+		block->~U();
+	}
+	
+	// Miscellaneous functions required by (older) standard libraries
+	T* address(T& value) const { return &value; }
+	const T* address(const T& value) const { return &value; }
+	size_t max_size() const { return ((size_t)-1)/sizeof(T); }
+};
+
+// Two allocators are equal if they allocate from the same arena
+template <class T, class U>
+bool operator==(const ArenaAllocator<T> &a, const ArenaAllocator<U> &b) { return a.arena == b.arena; }
+template <class T, class U>
+bool operator!=(const ArenaAllocator<T> &a, const ArenaAllocator<U> &b) { return a.arena != b.arena; }
+
+//////////////////////////////////
+
+#endif
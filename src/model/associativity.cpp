@@ -13,7 +13,8 @@
 // This particular file is contains a function to determine how addresses are
 // mapped to sets in a (hash) associative cache. In contains different settings,
 // including a straightfoward non-hash mapping, a basic XOR hash mapping, and
-// the Fermi GPU's hashing function.
+// the Fermi GPU's hashing function. The mapping is selected at run-time through
+// the MAPPING_TYPE setting.
 //
 // == File details
 // Filename...........src/model/associativity.cpp
@@ -26,16 +27,14 @@
 // Include the header file
 #include "model.h"
 
-// Set the type of associativity address to set mapping to consider
-#define MAPPING_TYPE 2
-
 //////////////////////////////////
 // Cache-line address to set mapping
 //////////////////////////////////
 unsigned line_addr_to_set(unsigned long line_addr,
                           unsigned long addr,
                           unsigned num_sets,
-                          unsigned cache_bytes) {
+                          unsigned cache_bytes,
+                          unsigned mapping_type) {
 	unsigned set = 0;
 	
 	// Generate groups of bits
@@ -52,17 +51,17 @@ unsigned line_addr_to_set(unsigned long line_addr,
 	}
 	
 	// Default mapping function (no 'hash')
-	if (MAPPING_TYPE == 0) {
+	if (mapping_type == 0) {
 		set = line_addr % num_sets;
 	}
 	
 	// Basic XOR hashing function
-	else if (MAPPING_TYPE == 1) {
+	else if (mapping_type == 1) {
 		set = (line_addr % num_sets) ^ ((line_addr/num_sets) % num_sets);
 	}
 	
 	// Fermi's hashing function
-	else if (MAPPING_TYPE == 2) {
+	else if (mapping_type == 2) {
 		unsigned b01234 = bits[0] + bits[1]*2 + bits[2]*4 + bits[3] *8 + bits[4] *16;
 		unsigned b678AC = bits[6] + bits[7]*2 + bits[8]*4 + bits[10]*8 + bits[12]*16;
 		assert(b01234 < 32);
@@ -0,0 +1,292 @@
+//////////////////////////////////
+//
+// == A reuse distance based GPU cache model
+// This file is part of a cache model for GPUs. The cache model is based on
+// reuse distance theory extended to work with GPUs. The cache model primarly
+// focusses on modelling NVIDIA's Fermi architecture.
+//
+// == More information on the GPU cache model
+// Article............A Detailed GPU Cache Model Based on Reuse Distance Theory
+// Authors............C. Nugteren et al.
+//
+// == Contents of this file
+// This particular file implements a persistent cache of modelling results. The
+// results of a kernel (its reuse distance histograms) are stored on disk, keyed
+// by a content hash of the trace file, all the hardware settings and the model
+// options which influence the results. Re-running the model for an unchanged
+// trace and configuration loads the results instead of recomputing them. The
+// cache-files are stored in the 'temp/cache' folder and can be removed at will.
+//
+// == File details
+// Filename...........src/model/cache.cpp
+// Author.............Cedric Nugteren <www.cedricnugteren.nl>
+// Affiliation........Eindhoven University of Technology, The Netherlands
+// Last modified on...16-Oct-2026
+//
+//////////////////////////////////
+
+// Include the header file
+#include "model.h"
+
+// System headers (to create the cache folder)
+#include <sys/stat.h>
+
+// Standard headers (to write the sample rate at full precision)
+#include <iomanip>
+
+// Global settings for the directory structure (see src/model/io.cpp)
+extern std::string output_dir;
+extern std::string temp_dir;
+
+//////////////////////////////////
+// Helper function to add bytes to a 64-bit FNV-1a hash
+//////////////////////////////////
+unsigned long fnv_hash(unsigned long hash,
+                       const char* data,
+                       size_t bytes) {
+	for (size_t i=0; i<bytes; i++) {
+		hash ^= (unsigned char)data[i];
+		hash *= FNV_PRIME;
+	}
+	return hash;
+}
+
+//////////////////////////////////
+// Helper function to compute the 64-bit FNV-1a hash of the contents of a file
+//////////////////////////////////
+unsigned long hash_file(std::ifstream &input_file) {
+	unsigned long hash = FNV_OFFSET;
+	std::vector<char> buffer(1024*1024);
+	while (input_file.read(buffer.data(), buffer.size()) || input_file.gcount() > 0) {
+		hash = fnv_hash(hash, buffer.data(), input_file.gcount());
+	}
+	return hash;
+}
+
+//////////////////////////////////
+// Function to create the key of the result cache for a kernel: a hash of the
+// contents of the trace file, all the hardware settings and the model options
+// which influence the results. Returns an empty key if the trace does not exist.
+//////////////////////////////////
+std::string get_cache_key(const std::string kernelname,
+                          const std::string benchname,
+                          const Settings hardware,
+                          const Options options) {
+	std::ifstream input_file(output_dir+"/"+benchname+"/"+kernelname+".trc", std::ios::binary);
+	if (!input_file) {
+		return "";
+	}
+	
+	// Hash the contents of the trace file
+	unsigned long hash = hash_file(input_file);
+	
+	// Create the key including the settings and the options
+	std::ostringstream key;
+	key << "version=" << CACHE_VERSION << ";trace=" << std::hex << hash << std::dec;
+	for (unsigned k=0; k<NUM_SETTING_KEYS; k++) {
+		key << ";" << SETTING_KEYS[k].name << "=" << hardware.*(SETTING_KEYS[k].field);
+	}
+	key << ";sample_rate=" << std::setprecision(17) << options.sample_rate << std::setprecision(6) << ";parallel=" << (options.num_workers > 1) << ";seed=" << options.seed
+	    << ";bandwidth_window=" << options.bandwidth_window << ";slots=" << options.slot_output;
+	
+	// Include the contents of the latency histogram (if any)
+	if (options.latency_file != "") {
+		std::ifstream latency_file(options.latency_file, std::ios::binary);
+		key << ";latencies=" << std::hex << hash_file(latency_file) << std::dec;
+	}
+	
+	// Include the contents of the buffer map (if any)
+	if (options.buffer_file != "") {
+		std::ifstream buffer_file(options.buffer_file, std::ios::binary);
+		key << ";buffers=" << std::hex << hash_file(buffer_file) << std::dec;
+	}
+	return key.str();
+}
+
+//////////////////////////////////
+// Helper function to get the name of the cache-file for a given key
+//////////////////////////////////
+std::string get_cache_filename(const std::string key) {
+	std::ostringstream filename;
+	filename << temp_dir << "/cache/" << std::hex << fnv_hash(FNV_OFFSET, key.c_str(), key.size()) << ".cache";
+	return filename.str();
+}
+
+//////////////////////////////////
+// Helper functions to write and read a profile (e.g. per instruction slot) in a
+// cache-file: a line with the number of entries, followed by the entries
+//////////////////////////////////
+void write_cached_profile(std::ofstream &file,
+                          const std::string name,
+                          const AccessProfile &profile) {
+	std::vector<std::pair<unsigned long,unsigned>> entries = profile.sorted();
+	file << name << ": " << entries.size() << std::endl;
+	for (unsigned e=0; e<entries.size(); e++) {
+		file << entries[e].first << " " << entries[e].second << std::endl;
+	}
+}
+bool read_cached_profile(std::ifstream &input_file,
+                         AccessProfile &profile) {
+	std::string temp_string;
+	unsigned num_entries;
+	if (!(input_file >> temp_string >> num_entries)) {
+		return false;
+	}
+	for (unsigned e=0; e<num_entries; e++) {
+		unsigned long key;
+		unsigned frequency;
+		if (!(input_file >> key >> frequency)) {
+			return false;
+		}
+		profile.set(key, frequency);
+	}
+	return true;
+}
+
+//////////////////////////////////
+// Function to load the results of a kernel from the cache. Returns false if
+// the results are not in the cache (or if the cache-file is invalid).
+//////////////////////////////////
+bool load_cached_result(const std::string key,
+                        const Settings hardware,
+                        const Options options,
+                        Result &result) {
+	std::ifstream input_file(get_cache_filename(key));
+	if (!input_file) {
+		return false;
+	}
+	
+	// Test whether the file was stored for the same key (to detect hash collisions)
+	std::string file_key;
+	std::getline(input_file, file_key);
+	if (file_key != key) {
+		return false;
+	}
+	
+	// Read the number of active blocks and the histograms (including those of the L2,
+	// texture and constant caches)
+	Result cached;
+	unsigned num_histograms;
+	std::string temp_string;
+	if (!(input_file >> temp_string >> cached.active_blocks >> temp_string >> num_histograms) || num_histograms > NUM_HISTOGRAMS) {
+		return false;
+	}
+	cached.distances.resize(num_histograms);
+	for (unsigned c=0; c<cached.distances.size(); c++) {
+		unsigned num_entries, num_buckets;
+		if (!(input_file >> temp_string >> num_entries >> num_buckets)) {
+			return false;
+		}
+		std::vector<std::pair<unsigned,unsigned>> entries(num_entries);
+		for (unsigned e=0; e<num_entries; e++) {
+			if (!(input_file >> entries[e].first >> entries[e].second)) {
+				return false;
+			}
+		}
+		
+		// Insert in reverse order into the same number of buckets: this restores the
+		// original order of the histogram, such that the output files are identical
+		#if __cplusplus > 199711L
+			cached.distances[c].rehash(num_buckets);
+		#endif
+		for (unsigned e=num_entries; e>0; e--) {
+			cached.distances[c][entries[e-1].first] = entries[e-1].second;
+		}
+	}
+	
+	// Read the write traffic (only stored if stores are modelled)
+	cached.writes = WriteStats({0,0,0,0,0,0});
+	if (hardware.write_policy != 0) {
+		WriteStats &writes = cached.writes;
+		if (!(input_file >> temp_string >> writes.stores >> writes.store_hits >> writes.store_misses
+		                 >> writes.write_evictions >> writes.write_backs >> writes.write_bytes)) {
+			return false;
+		}
+	}
+	
+	// Read the sector traffic (only stored in sectored mode)
+	cached.sectors = SectorStats({0,0,0});
+	if (hardware.sector_size > 0) {
+		SectorStats &sectors = cached.sectors;
+		if (!(input_file >> temp_string >> sectors.sector_misses >> sectors.fetched_sectors >> sectors.fetched_bytes)) {
+			return false;
+		}
+	}
+	
+	// Read the bandwidth demand
+	BandwidthStats &bandwidth = cached.bandwidth;
+	if (!(input_file >> temp_string >> bandwidth.bytes >> bandwidth.cycles >> bandwidth.window >> bandwidth.peak_bytes)) {
+		return false;
+	}
+	
+	// Read the histograms per instruction slot and per buffer (empty unless profiled)
+	if (!read_cached_profile(input_file, cached.slots) || !read_cached_profile(input_file, cached.buffers)) {
+		return false;
+	}
+	
+	// Derive the cache misses from the histograms (nothing had to be modelled)
+	cached.misses = compute_misses(cached.distances, hardware, options);
+	cached.timings.schedule = 0;
+	for (unsigned c=0; c<NUM_CASES; c++) {
+		cached.timings.cases[c] = 0;
+	}
+	cached.timings.l2 = 0;
+	cached.timings.total = 0;
+	result = cached;
+	return true;
+}
+
+//////////////////////////////////
+// Function to store the results of a kernel in the cache. The file is written
+// under a temporary name first, such that an interrupted or concurrent run
+// never leaves behind a partial cache-file.
+//////////////////////////////////
+void store_cached_result(const std::string key,
+                         const Settings hardware,
+                         const Result &result) {
+	mkdir(temp_dir.c_str(), 0755);
+	mkdir((temp_dir+"/cache").c_str(), 0755);
+	std::string filename = get_cache_filename(key);
+	std::ostringstream temp_filename;
+	temp_filename << filename << "." << std::this_thread::get_id() << ".tmp";
+	
+	// Write the key, the number of active blocks and the histograms
+	std::ofstream file(temp_filename.str());
+	if (!file) {
+		return;
+	}
+	file << key << std::endl;
+	file << "active_blocks: " << result.active_blocks << std::endl;
+	file << "histograms: " << result.distances.size() << std::endl;
+	for (unsigned c=0; c<result.distances.size(); c++) {
+		unsigned num_buckets = 0;
+		#if __cplusplus > 199711L
+			num_buckets = result.distances[c].bucket_count();
+		#endif
+		file << "case_" << c << ": " << result.distances[c].size() << " " << num_buckets << std::endl;
+		for(map_type<unsigned,unsigned>::const_iterator it=result.distances[c].begin(); it!= result.distances[c].end(); it++) {
+			file << it->first << " " << it->second << std::endl;
+		}
+	}
+	if (hardware.write_policy != 0) {
+		const WriteStats &writes = result.writes;
+		file << "writes: " << writes.stores << " " << writes.store_hits << " " << writes.store_misses << " "
+		     << writes.write_evictions << " " << writes.write_backs << " " << writes.write_bytes << std::endl;
+	}
+	if (hardware.sector_size > 0) {
+		const SectorStats &sectors = result.sectors;
+		file << "sectors: " << sectors.sector_misses << " " << sectors.fetched_sectors << " " << sectors.fetched_bytes << std::endl;
+	}
+	const BandwidthStats &bandwidth = result.bandwidth;
+	file << "bandwidth: " << bandwidth.bytes << " " << bandwidth.cycles << " " << bandwidth.window << " " << bandwidth.peak_bytes << std::endl;
+	write_cached_profile(file, "slots", result.slots);
+	write_cached_profile(file, "buffers", result.buffers);
+	file.close();
+	
+	// Move the file into place
+	if (!file || std::rename(temp_filename.str().c_str(), filename.c_str()) != 0) {
+		std::remove(temp_filename.str().c_str());
+	}
+}
+
+//////////////////////////////////
@@ -36,9 +36,10 @@ std::string config_dir = "configurations";
 //////////////////////////////////
 Dim3 read_file(std::vector<Thread> &threads,
                const std::string kernelname,
-               const std::string benchname) {
-	unsigned num_threads = 0;
-	unsigned num_accesses = 0;
+               const std::string benchname,
+               const Options options,
+               bool keep_stores) {
+	std::ostream &out = *options.output;
 	std::string filename = output_dir+"/"+benchname+"/"+kernelname+".trc";
 	
 	// Test if the file exists, return if it does not exist
@@ -47,24 +48,75 @@ Dim3 read_file(std::vector<Thread> &threads,
 		return Dim3({0,0,0});
 	}
 	
-	// Open the file for reading
-	std::cout << SPLIT_STRING << std::endl;
-	message("");
-	std::cout << "### Reading the trace file for '" << kernelname << "'...";
+	// Read the trace and report on the progress
+	out << SPLIT_STRING << std::endl;
+	message(out, "");
+	out << "### Reading the trace file for '" << kernelname << "'...";
+	return read_trace(threads, filename, options, keep_stores);
+}
+
+//////////////////////////////////
+// Function to parse a memory access trace from a given file (the threads vector
+// should be large enough to hold all threads, it is resized afterwards). Stores
+// are only kept if they are modelled (see the write policy), such that they cost
+// nothing otherwise. Texture and constant loads are always kept.
+//////////////////////////////////
+Dim3 read_trace(std::vector<Thread> &threads,
+                const std::string filename,
+                const Options options,
+                bool keep_stores) {
+	std::ostream &out = *options.output;
+	unsigned num_threads = 0;
+	unsigned num_accesses = 0;
+	
+	// Open the file for reading (return if it does not exist)
 	std::ifstream input_file(filename);
+	if (!input_file) {
+		return Dim3({0,0,0});
+	}
 	
 	// First get the blocksize from the trace file
 	std::string temp_string;
 	Dim3 blockdim;
 	input_file >> temp_string >> blockdim.x >> blockdim.y >> blockdim.z;
-	
-	// Then proceed to the actual trace data
 	unsigned thread, direction, bytes;
 	unsigned long address;
+	
+	// The accesses do not fit in the memory budget: count the accesses per thread
+	// first, and store them in a spill-file (thread after thread, such that the
+	// accesses of a warp are stored together). The whole kernel is spilled, and the
+	// accesses are spilled as read, before coalescing: coalescing only disables the
+	// merged accesses in place (the slots and the sector masks still use them), so
+	// spilling after coalescing would not store fewer accesses.
+	std::shared_ptr<SpillFile> spill_file;
+	if (options.spill && estimate_trace_memory(filename) > get_memory_budget(options)) {
+		std::vector<unsigned long> offsets(threads.size()+1,0);
+		while (input_file >> thread >> direction >> address >> bytes) {
+			if (direction != 1 || keep_stores) { offsets[thread+1]++; }
+		}
+		for (unsigned tid=0; tid<threads.size(); tid++) {
+			offsets[tid+1] += offsets[tid];
+		}
+		if (options.verbose) {
+			out << "spilling " << (offsets[threads.size()]*sizeof(Access))/(1024*1024) << "MB to a file...";
+		}
+		spill_file = std::make_shared<SpillFile>(temp_dir, offsets[threads.size()]*sizeof(Access));
+		Access* spill_data = static_cast<Access*>(spill_file->get_data());
+		for (unsigned tid=0; tid<threads.size(); tid++) {
+			threads[tid].set_spilled(spill_file, spill_data+offsets[tid]);
+		}
+		
+		// Start reading the trace again
+		input_file.clear();
+		input_file.seekg(0);
+		input_file >> temp_string >> blockdim.x >> blockdim.y >> blockdim.z;
+	}
+	
+	// Then proceed to the actual trace data
 	while (input_file >> thread >> direction >> address >> bytes) {
 		
-		// Consider only loads (stores are not cached in Fermi's L1 caches)
-		if (direction == 0) {
+		// Consider only loads, unless stores are modelled (they are not cached in Fermi's L1 caches)
+		if (direction != 1 || keep_stores) {
 		
 			// Count the number of accesses and threads
 			num_accesses++;
@@ -75,12 +127,19 @@ Dim3 read_file(std::vector<Thread> &threads,
 			threads[thread].append_access(access);
 		}
 	}
-	std::cout << "done" << std::endl;
+	if (options.verbose) { out << "done" << std::endl; }
+	
+	// Write the spilled accesses back to the file and release the memory
+	if (spill_file) {
+		spill_file->release();
+	}
 	
 	// Test if the file actually contained memory accesses - exit otherwise
 	if (!(num_accesses > 0 && num_threads > 0)) {
-		std::cout << "### Error: '" << filename << "' is not a valid memory access trace" << std::endl;
-		message("");
+		if (options.verbose) {
+			out << "### Error: '" << filename << "' is not a valid memory access trace" << std::endl;
+			message(out, "");
+		}
 		return Dim3({0,0,0});
 	}
 	
@@ -89,19 +148,25 @@ Dim3 read_file(std::vector<Thread> &threads,
 	threads.shrink_to_fit();
 	
 	// Print additional information and return the threadblock dimensions
-	std::cout << "### Blocksize: (" << blockdim.x << "," << blockdim.y << "," << blockdim.z << ")" << std::endl;
-	std::cout << "### Total threads: " << num_threads << std::endl;
-	std::cout << "### Total memory accesses: " << num_accesses << "" << std::endl;
+	if (options.verbose) {
+		out << "### Blocksize: (" << blockdim.x << "," << blockdim.y << "," << blockdim.z << ")" << std::endl;
+		out << "### Total threads: " << num_threads << std::endl;
+		out << "### Total memory accesses: " << num_accesses << "" << std::endl;
+	}
 	return blockdim;
 }
 
 //////////////////////////////////
 // Function to output the histogram and the cache miss rate to file and stdout
 //////////////////////////////////
-void output_miss_rate(std::vector<map_type<unsigned,unsigned>> &distances,
+void output_miss_rate(Result &result,
                       const std::string kernelname,
                       const std::string benchname,
-                      const Settings hardware) {
+                      const Settings hardware,
+                      const Options options) {
+	std::ostream &out = *options.output;
+	std::vector<map_type<unsigned,unsigned>> &distances = result.distances;
+	const Misses &misses = result.misses;
 	
 	// Prepare the output file and output some hardware settings
 	std::ofstream file;
@@ -111,6 +176,7 @@ void output_miss_rate(std::vector<map_type<unsigned,unsigned>> &distances,
 	file << "cache_lines: " << hardware.cache_lines << std::endl;
 	file << "cache_ways: " << hardware.cache_ways << std::endl;
 	file << "cache_sets: " << hardware.cache_sets << std::endl;
+	file << "seed: " << options.seed << std::endl;
 	
 	// Sort the reuse distances and print them to file
 	std::map<unsigned,unsigned> sorted_distances;
@@ -122,114 +188,533 @@ void output_miss_rate(std::vector<map_type<unsigned,unsigned>> &distances,
 	file << std::endl;
 	
 	// Print the sorted reuse distance histogram to stdout
-	message("Printing results as [reuse_distance] => frequency: ");
+	message(out, "Printing results as [reuse_distance] => frequency: ");
 	unsigned count = 0;
 	for(std::map<unsigned,unsigned>::reverse_iterator it=sorted_distances.rbegin(); it!= sorted_distances.rend(); it++) {
 		
 		// Print to stdout
-		if (it->second == INF) { std::cout << "### %%% [inf] => " << it->first << "" << std::endl; }
-		else { std::cout << "### %%% [" << it->second << "] => " << it->first << "" << std::endl; }
+		if (it->second == INF) { out << "### %%% [inf] => " << it->first << "" << std::endl; }
+		else { out << "### %%% [" << it->second << "] => " << it->first << "" << std::endl; }
 		
 		// Break after printing the X most interesting values
 		if (count > PRINT_MAX_DISTANCES) { break; }
 		count++;
 	}
 	
-	// Prepare to gather the cache miss rates
-	message("");
-	std::cout << "### Modeled cache miss rate:" << std::endl;
-	unsigned miss_compulsory[NUM_CASES] = {0, 0, 0, 0};
-	unsigned miss_capacity[NUM_CASES] = {0, 0, 0, 0};
-	unsigned miss[NUM_CASES];
-	unsigned hits = 0;
-	
-	// Compute the cache misses for the 4 different cases
-	for (int i=0; i<NUM_CASES; i++) {
-		for(map_type<unsigned,unsigned>::iterator it=distances[i].begin(); it!= distances[i].end(); it++) {
-			unsigned cache_ways = hardware.cache_ways;
-			if (i == 1) { cache_ways = hardware.cache_ways*hardware.cache_sets; }
-			
-			// Compute the compulsory and capacity misses
-			if (it->first == INF) {
-				miss_compulsory[i] += it->second;
-			}
-			else if (it->first > cache_ways ) {
-				miss_capacity[i] += it->second;
-			}
-			
-			// Compute the hits
-			else if (i == 0) {
-				hits += it->second;
-			}
-		}
-		miss[i] = miss_compulsory[i] + miss_capacity[i];
-	}
+	// Prepare to report the cache miss rates
+	message(out, "");
+	out << "### Modeled cache miss rate:" << std::endl;
 	
 	// Check for possible problems
 	#ifdef ENABLE_WARNINGS
-		if ((float)miss[1] > (float)miss[0]*WARNING_FACTOR) {
-			std::cout << "### [warning] more misses with full-associativity (" << miss[1] << ") than with set-associativity (" << miss[0] << ")" << std::endl;
+		if ((float)misses.total_associativity > (float)misses.total*WARNING_FACTOR) {
+			out << "### [warning] more misses with full-associativity (" << misses.total_associativity << ") than with set-associativity (" << misses.total << ")" << std::endl;
 		}
-		if ((float)miss[2] > (float)miss[0]*WARNING_FACTOR) {
-			std::cout << "### [warning] more misses without latency (" << miss[2] << ") than with latency (" << miss[0] << ")" << std::endl;
+		if ((float)misses.total_latency > (float)misses.total*WARNING_FACTOR) {
+			out << "### [warning] more misses without latency (" << misses.total_latency << ") than with latency (" << misses.total << ")" << std::endl;
 		}
-		if ((float)miss[3] > (float)miss[0]*WARNING_FACTOR) {
-			std::cout << "### [warning] more misses with unlimited MSHRs (" << miss[3] << ") than with limited MSHRs (" << miss[0] << ")" << std::endl;
+		if ((float)misses.total_mshr > (float)misses.total*WARNING_FACTOR) {
+			out << "### [warning] more misses with unlimited MSHRs (" << misses.total_mshr << ") than with limited MSHRs (" << misses.total << ")" << std::endl;
 		}
 	#endif
 	
-	// Compute the various types of cache miss rates
-	int miss_associativity = miss[0] - miss[1];
-	int miss_latency       = miss_compulsory[0] - miss_compulsory[2];
-	int miss_mshr          = miss[0] - miss[3];
-	miss_compulsory[0] = miss_compulsory[2];
-	int rest = miss[0] - (miss_compulsory[0] + std::max(0,miss_latency) + std::max(0,miss_associativity) + std::max(0,miss_mshr));
-	miss_capacity[0] = std::max(0,rest);
-	if (rest < 0) {
-		if (miss_mshr > -rest) {         miss_mshr          = miss_mshr          - rest; }
-		else if (miss_latency > -rest) { miss_latency       = miss_latency       - rest; }
-		else {                           miss_associativity = miss_associativity - rest; }
-	}
-	
-	// Compute the final cache miss rates
-	unsigned total_misses = miss[0];
-	unsigned total_accesses = total_misses + hits;
-	float miss_rate = 100*total_misses/(float)(total_accesses);
-
 	// Report the cache hit/miss rates to stdout
-	std::cout << "### \t Total accesses: "         << total_accesses << std::endl;
-	std::cout << "### \t Of which are misses: "    << miss_compulsory[0] << " + " << miss_capacity[0] << " + " << std::max(0,miss_associativity) << " + " << std::max(0,miss_latency) << " + " << std::max(0,miss_mshr) << " = " << total_misses << " (compulsory + capacity + associativity + latency + mshr = total)" << std::endl;
-	std::cout << "### \t Of which are hits: "      << hits << std::endl;
-	std::cout << "### \t Miss rate: "              << miss_rate << "%" << std::endl;
+	out << "### \t Total accesses: "         << misses.accesses << std::endl;
+	out << "### \t Of which are misses: "    << misses.compulsory << " + " << misses.capacity << " + " << misses.associativity << " + " << misses.latency << " + " << misses.mshr << " = " << misses.total << " (compulsory + capacity + associativity + latency + mshr = total)" << std::endl;
+	out << "### \t Of which are hits: "      << misses.hits << std::endl;
+	out << "### \t Miss rate: "              << misses.miss_rate << "%" << std::endl;
+	if (options.sample_rate < 1.0) {
+		out << "### \t Sample rate: "          << options.sample_rate << " (error bound: +/- " << misses.error_bound << "%)" << std::endl;
+	}
+	if (result.miss_rates.size() > 1) {
+		out << "### \t Miss rate over " << result.miss_rates.size() << " seeds: " << mean(result.miss_rates) << "% (variance: " << variance(result.miss_rates) << ")" << std::endl;
+	}
+	if (misses.tex_accesses > 0) {
+		out << "### \t Texture accesses: "     << misses.tex_accesses << " (" << misses.tex_misses << " misses, miss rate " << misses.tex_miss_rate << "%)" << std::endl;
+	}
+	if (misses.const_accesses > 0) {
+		out << "### \t Constant accesses: "    << misses.const_accesses << " (" << misses.const_misses << " misses, miss rate " << misses.const_miss_rate << "%)" << std::endl;
+	}
+	if (hardware.l2_bytes > 0) {
+		out << "### \t L2 accesses: "          << misses.l2_accesses << " (" << misses.l2_hits << " hits + " << misses.l2_misses << " misses)" << std::endl;
+		out << "### \t L2 miss rate: "         << misses.l2_miss_rate << "%" << std::endl;
+		out << "### \t Memory traffic: "       << (unsigned long)misses.l2_accesses*hardware.line_size << " bytes L1-L2, "
+		                                      << (unsigned long)misses.l2_misses*hardware.line_size << " bytes L2-DRAM" << std::endl;
+	}
+	if (hardware.write_policy != 0) {
+		const WriteStats &writes = result.writes;
+		out << "### \t Stores: "               << writes.stores << " (" << writes.store_hits << " hits + " << writes.store_misses << " misses)" << std::endl;
+		out << "### \t Write traffic: "        << writes.write_bytes << " bytes (" << ((hardware.write_policy == 1) ? "write-through" : "write-back") << ", "
+		                                      << writes.write_backs << " write-backs, " << writes.write_evictions << " write-induced evictions)" << std::endl;
+	}
+	if (hardware.sector_size > 0) {
+		const SectorStats &sectors = result.sectors;
+		out << "### \t Sector misses: "        << sectors.sector_misses << " (tag hits missing a sector)" << std::endl;
+		out << "### \t Fill traffic: "         << sectors.fetched_bytes << " bytes (" << sectors.fetched_sectors << " sectors of " << hardware.sector_size << " bytes)" << std::endl;
+	}
+	out << "### \t Bandwidth demand: "     << average_bandwidth(result.bandwidth) << " bytes/cycle on average, " << peak_bandwidth(result.bandwidth) << " bytes/cycle at peak ("
+	                                      << result.bandwidth.bytes << " bytes requested in " << result.bandwidth.cycles << " cycles)" << std::endl;
+	out << "### \t DRAM traffic: "         << dram_bytes(result, hardware) << " bytes" << std::endl;
+	
+	// Report the instruction slots with the most misses to stdout (if profiled)
+	const char* cache_names[3] = { "L1", "texture", "constant" };
+	std::vector<ProfileStats> slot_stats;
+	std::vector<std::string> instructions;
+	if (options.slot_output) {
+		slot_stats = profile_statistics(result.slots, hardware);
+		instructions = read_slot_instructions(output_dir+"/"+benchname+"/"+kernelname+".slots", hardware.write_policy != 0);
+		std::vector<ProfileStats> worst_slots = slot_stats;
+		std::stable_sort(worst_slots.begin(), worst_slots.end(), [](const ProfileStats &a, const ProfileStats &b) {
+			return a.misses > b.misses;
+		});
+		for (unsigned i=0; i<worst_slots.size() && i<PRINT_MAX_SLOTS; i++) {
+			const ProfileStats &stats = worst_slots[i];
+			out << "### \t Slot " << stats.index << " (" << cache_names[stats.cache] << "): " << stats.misses << " misses of " << stats.accesses << " accesses";
+			if (stats.index < instructions.size()) { out << " [" << instructions[stats.index] << "]"; }
+			out << std::endl;
+		}
+	}
+	
+	// Report the accesses and misses of each buffer to stdout (if attributed)
+	std::vector<ProfileStats> buffer_stats;
+	if (options.buffer_map) {
+		const std::vector<Buffer> &buffer_list = options.buffer_map->get_buffers();
+		buffer_stats = profile_statistics(result.buffers, hardware);
+		for (unsigned i=0; i<buffer_stats.size(); i++) {
+			const ProfileStats &stats = buffer_stats[i];
+			std::string name = (stats.index < buffer_list.size()) ? buffer_list[stats.index].name : "(other)";
+			out << "### \t Buffer " << name << " (" << cache_names[stats.cache] << "): " << stats.misses << " misses of " << stats.accesses
+			    << " accesses (miss rate " << 100*stats.misses/(float)stats.accesses << "%)" << std::endl;
+		}
+	}
+	out << "### \t Modelling time: "         << result.timings.total << "s" << std::endl;
 	
 	// Report the cache hit/miss rates to file
-	file << "modelled_accesses: "                  << total_accesses                  << std::endl;
-	file << "modelled_misses(compulsory): "        << miss_compulsory[0]              << std::endl;
-	file << "modelled_misses(capacity): "          << miss_capacity[0]                << std::endl;
-	file << "modelled_misses(associativity): "     << std::max(0,miss_associativity)  << std::endl;
-	file << "modelled_misses(latency): "           << std::max(0,miss_latency)        << std::endl;
-	file << "modelled_misses(mshr): "              << std::max(0,miss_mshr)           << std::endl;
-	file << "modelled_misses(tot_associativity): " << miss[1]                         << std::endl;
-	file << "modelled_misses(tot_latency): "       << miss[2]                         << std::endl;
-	file << "modelled_misses(tot_mshr): "          << miss[3]                         << std::endl;
-	file << "modelled_hits: "                      << hits                            << std::endl;
-	file << "modelled_miss_rate: "                 << miss_rate                       << std::endl;
+	file << "modelled_accesses: "                  << misses.accesses                 << std::endl;
+	file << "modelled_misses(compulsory): "        << misses.compulsory               << std::endl;
+	file << "modelled_misses(capacity): "          << misses.capacity                 << std::endl;
+	file << "modelled_misses(associativity): "     << misses.associativity            << std::endl;
+	file << "modelled_misses(latency): "           << misses.latency                  << std::endl;
+	file << "modelled_misses(mshr): "              << misses.mshr                     << std::endl;
+	file << "modelled_misses(tot_associativity): " << misses.total_associativity      << std::endl;
+	file << "modelled_misses(tot_latency): "       << misses.total_latency            << std::endl;
+	file << "modelled_misses(tot_mshr): "          << misses.total_mshr               << std::endl;
+	file << "modelled_hits: "                      << misses.hits                     << std::endl;
+	file << "modelled_miss_rate: "                 << misses.miss_rate                << std::endl;
+	if (options.sample_rate < 1.0) {
+		file << "modelled_sample_rate: "             << options.sample_rate             << std::endl;
+		file << "modelled_error_bound: "             << misses.error_bound              << std::endl;
+	}
+	if (result.miss_rates.size() > 1) {
+		file << "modelled_num_seeds: "               << result.miss_rates.size()        << std::endl;
+		file << "modelled_miss_rate_mean: "          << mean(result.miss_rates)         << std::endl;
+		file << "modelled_miss_rate_variance: "      << variance(result.miss_rates)     << std::endl;
+	}
+	if (hardware.write_policy != 0) {
+		file << "modelled_stores: "                  << result.writes.stores            << std::endl;
+		file << "modelled_store_hits: "              << result.writes.store_hits        << std::endl;
+		file << "modelled_store_misses: "            << result.writes.store_misses      << std::endl;
+		file << "modelled_write_evictions: "         << result.writes.write_evictions   << std::endl;
+		file << "modelled_write_backs: "             << result.writes.write_backs       << std::endl;
+		file << "modelled_write_bytes: "             << result.writes.write_bytes       << std::endl;
+	}
+	if (hardware.sector_size > 0) {
+		file << "modelled_sector_misses: "           << result.sectors.sector_misses    << std::endl;
+		file << "modelled_fetched_sectors: "         << result.sectors.fetched_sectors  << std::endl;
+		file << "modelled_fetched_bytes: "           << result.sectors.fetched_bytes    << std::endl;
+	}
+	if (misses.tex_accesses > 0) {
+		file << "modelled_tex_accesses: "            << misses.tex_accesses             << std::endl;
+		file << "modelled_tex_misses: "              << misses.tex_misses               << std::endl;
+		file << "modelled_tex_miss_rate: "           << misses.tex_miss_rate            << std::endl;
+	}
+	if (misses.const_accesses > 0) {
+		file << "modelled_const_accesses: "          << misses.const_accesses           << std::endl;
+		file << "modelled_const_misses: "            << misses.const_misses             << std::endl;
+		file << "modelled_const_miss_rate: "         << misses.const_miss_rate          << std::endl;
+	}
+	file << "modelled_request_bytes: "             << result.bandwidth.bytes          << std::endl;
+	file << "modelled_cycles: "                    << result.bandwidth.cycles         << std::endl;
+	file << "modelled_bandwidth_average: "         << average_bandwidth(result.bandwidth) << std::endl;
+	file << "modelled_bandwidth_peak: "            << peak_bandwidth(result.bandwidth)    << std::endl;
+	file << "modelled_bandwidth_window: "          << result.bandwidth.window         << std::endl;
+	file << "modelled_total_dram_bytes: "          << dram_bytes(result, hardware)    << std::endl;
+	if (hardware.l2_bytes > 0) {
+		file << "modelled_l2_accesses: "             << misses.l2_accesses              << std::endl;
+		file << "modelled_l2_hits: "                 << misses.l2_hits                  << std::endl;
+		file << "modelled_l2_misses: "               << misses.l2_misses                << std::endl;
+		file << "modelled_l2_miss_rate: "            << misses.l2_miss_rate             << std::endl;
+		file << "modelled_l1_l2_bytes: "             << (unsigned long)misses.l2_accesses*hardware.line_size << std::endl;
+		file << "modelled_dram_bytes: "              << (unsigned long)misses.l2_misses*hardware.line_size   << std::endl;
+	}
 	
 	// Close the output file
 	file.close();
+	
+	// Write the results in the structured formats (if requested)
+	if (options.json_output) {
+		output_json(result, kernelname, benchname, hardware, options);
+	}
+	if (options.histogram_format != "") {
+		output_histograms(result, kernelname, benchname, options);
+	}
+	if (options.mrc_output) {
+		output_mrc(result, kernelname, benchname, hardware);
+	}
+	if (options.slot_output) {
+		output_slots(slot_stats, instructions, result, kernelname, benchname);
+	}
+	if (options.buffer_map) {
+		output_buffers(buffer_stats, options.buffer_map->get_buffers(), result, kernelname, benchname);
+	}
+}
+
+//////////////////////////////////
+// Helper function to write a number as a JSON value (non-finite numbers are 'null')
+//////////////////////////////////
+std::string json_number(double value) {
+	if (!std::isfinite(value)) { return "null"; }
+	std::ostringstream number;
+	number << value;
+	return number.str();
+}
+
+//////////////////////////////////
+// Function to write a summary of the results to a JSON file: the hardware settings,
+// the model options and the cache misses and their causes
+//////////////////////////////////
+void output_json(const Result &result,
+                 const std::string kernelname,
+                 const std::string benchname,
+                 const Settings hardware,
+                 const Options options) {
+	const Misses &misses = result.misses;
+	std::ofstream file(output_dir+"/"+benchname+"/"+kernelname+".json");
+	
+	// The kernel and the hardware settings
+	file << "{" << std::endl;
+	file << "  \"kernel\": \"" << kernelname << "\"," << std::endl;
+	file << "  \"benchmark\": \"" << benchname << "\"," << std::endl;
+	file << "  \"settings\": {";
+	for (unsigned k=0; k<NUM_SETTING_KEYS; k++) {
+		file << ((k == 0) ? "" : ",") << std::endl << "    \"" << SETTING_KEYS[k].name << "\": " << hardware.*(SETTING_KEYS[k].field);
+	}
+	file << std::endl << "  }," << std::endl;
+	file << "  \"cache_lines\": " << hardware.cache_lines << "," << std::endl;
+	file << "  \"cache_sets\": " << hardware.cache_sets << "," << std::endl;
+	
+	// The model options
+	file << "  \"seed\": " << options.seed << "," << std::endl;
+	file << "  \"sample_rate\": " << json_number(options.sample_rate) << "," << std::endl;
+	file << "  \"active_blocks\": " << result.active_blocks << "," << std::endl;
+	
+	// The cache misses and their causes
+	file << "  \"accesses\": " << misses.accesses << "," << std::endl;
+	file << "  \"hits\": " << misses.hits << "," << std::endl;
+	file << "  \"misses\": {" << std::endl;
+	file << "    \"compulsory\": " << misses.compulsory << "," << std::endl;
+	file << "    \"capacity\": " << misses.capacity << "," << std::endl;
+	file << "    \"associativity\": " << misses.associativity << "," << std::endl;
+	file << "    \"latency\": " << misses.latency << "," << std::endl;
+	file << "    \"mshr\": " << misses.mshr << "," << std::endl;
+	file << "    \"total\": " << misses.total << "," << std::endl;
+	file << "    \"total_associativity\": " << misses.total_associativity << "," << std::endl;
+	file << "    \"total_latency\": " << misses.total_latency << "," << std::endl;
+	file << "    \"total_mshr\": " << misses.total_mshr << std::endl;
+	file << "  }," << std::endl;
+	file << "  \"miss_rate\": " << json_number(misses.miss_rate) << "," << std::endl;
+	if (options.sample_rate < 1.0) {
+		file << "  \"error_bound\": " << json_number(misses.error_bound) << "," << std::endl;
+	}
+	if (result.miss_rates.size() > 1) {
+		file << "  \"miss_rates\": [";
+		for (unsigned s=0; s<result.miss_rates.size(); s++) {
+			file << ((s == 0) ? "" : ", ") << json_number(result.miss_rates[s]);
+		}
+		file << "]," << std::endl;
+		file << "  \"miss_rate_mean\": " << json_number(mean(result.miss_rates)) << "," << std::endl;
+		file << "  \"miss_rate_variance\": " << json_number(variance(result.miss_rates)) << "," << std::endl;
+	}
+	if (hardware.write_policy != 0) {
+		file << "  \"writes\": {" << std::endl;
+		file << "    \"stores\": " << result.writes.stores << "," << std::endl;
+		file << "    \"store_hits\": " << result.writes.store_hits << "," << std::endl;
+		file << "    \"store_misses\": " << result.writes.store_misses << "," << std::endl;
+		file << "    \"write_evictions\": " << result.writes.write_evictions << "," << std::endl;
+		file << "    \"write_backs\": " << result.writes.write_backs << "," << std::endl;
+		file << "    \"write_bytes\": " << result.writes.write_bytes << std::endl;
+		file << "  }," << std::endl;
+	}
+	if (hardware.sector_size > 0) {
+		file << "  \"sectors\": {" << std::endl;
+		file << "    \"sector_misses\": " << result.sectors.sector_misses << "," << std::endl;
+		file << "    \"fetched_sectors\": " << result.sectors.fetched_sectors << "," << std::endl;
+		file << "    \"fetched_bytes\": " << result.sectors.fetched_bytes << std::endl;
+		file << "  }," << std::endl;
+	}
+	if (misses.tex_accesses > 0) {
+		file << "  \"texture\": {" << std::endl;
+		file << "    \"accesses\": " << misses.tex_accesses << "," << std::endl;
+		file << "    \"misses\": " << misses.tex_misses << "," << std::endl;
+		file << "    \"miss_rate\": " << json_number(misses.tex_miss_rate) << std::endl;
+		file << "  }," << std::endl;
+	}
+	if (misses.const_accesses > 0) {
+		file << "  \"constant\": {" << std::endl;
+		file << "    \"accesses\": " << misses.const_accesses << "," << std::endl;
+		file << "    \"misses\": " << misses.const_misses << "," << std::endl;
+		file << "    \"miss_rate\": " << json_number(misses.const_miss_rate) << std::endl;
+		file << "  }," << std::endl;
+	}
+	if (hardware.l2_bytes > 0) {
+		file << "  \"l2\": {" << std::endl;
+		file << "    \"accesses\": " << misses.l2_accesses << "," << std::endl;
+		file << "    \"hits\": " << misses.l2_hits << "," << std::endl;
+		file << "    \"misses\": " << misses.l2_misses << "," << std::endl;
+		file << "    \"miss_rate\": " << json_number(misses.l2_miss_rate) << "," << std::endl;
+		file << "    \"l1_l2_bytes\": " << (unsigned long)misses.l2_accesses*hardware.line_size << "," << std::endl;
+		file << "    \"dram_bytes\": " << (unsigned long)misses.l2_misses*hardware.line_size << std::endl;
+		file << "  }," << std::endl;
+	}
+	
+	// The bandwidth demand and the DRAM traffic
+	file << "  \"bandwidth\": {" << std::endl;
+	file << "    \"request_bytes\": " << result.bandwidth.bytes << "," << std::endl;
+	file << "    \"cycles\": " << result.bandwidth.cycles << "," << std::endl;
+	file << "    \"window\": " << result.bandwidth.window << "," << std::endl;
+	file << "    \"average\": " << json_number(average_bandwidth(result.bandwidth)) << "," << std::endl;
+	file << "    \"peak\": " << json_number(peak_bandwidth(result.bandwidth)) << "," << std::endl;
+	file << "    \"dram_bytes\": " << dram_bytes(result, hardware) << std::endl;
+	file << "  }," << std::endl;
+	
+	// The time spent modelling
+	file << "  \"timings\": {" << std::endl;
+	file << "    \"schedule\": " << json_number(result.timings.schedule) << "," << std::endl;
+	file << "    \"cases\": [";
+	for (unsigned c=0; c<NUM_CASES; c++) {
+		file << ((c == 0) ? "" : ", ") << json_number(result.timings.cases[c]);
+	}
+	file << "]," << std::endl;
+	if (hardware.l2_bytes > 0) {
+		file << "    \"l2\": " << json_number(result.timings.l2) << "," << std::endl;
+	}
+	file << "    \"total\": " << json_number(result.timings.total) << std::endl;
+	file << "  }" << std::endl;
+	file << "}" << std::endl;
+	file.close();
+}
+
+//////////////////////////////////
+// Function to write the reuse distance histograms of all cases (normal, full-
+// associativity, no latency, unlimited MSHRs, and the L2, texture and constant
+// caches if modelled) sorted by distance, either as CSV (lines with 'case,dis-
+// tance,frequency') or in a compact binary format: the magic string, the number
+// of cases, and per case the number of entries followed by (distance,frequency)
+// pairs, all as 32-bit unsigned integers. Infinite reuse distances (compulsory
+// misses) are written as INF in both formats.
+//////////////////////////////////
+void output_histograms(const Result &result,
+                       const std::string kernelname,
+                       const std::string benchname,
+                       const Options options) {
+	bool binary = (options.histogram_format == "bin");
+	std::string filename = output_dir+"/"+benchname+"/"+kernelname+"_histograms."+options.histogram_format;
+	std::ofstream file(filename, (binary) ? std::ios::binary : std::ios::out);
+	
+	// Write the header
+	uint32_t num_cases = result.distances.size();
+	if (binary) {
+		file.write(HISTOGRAM_MAGIC, 4);
+		file.write((const char*)&num_cases, sizeof(uint32_t));
+	}
+	else {
+		file << "case,distance,frequency" << std::endl;
+	}
+	
+	// Write the histograms of all cases sorted by distance
+	for (uint32_t c=0; c<num_cases; c++) {
+		std::vector<std::pair<uint32_t,uint32_t>> entries(result.distances[c].begin(), result.distances[c].end());
+		std::sort(entries.begin(), entries.end());
+		if (binary) {
+			uint32_t num_entries = entries.size();
+			file.write((const char*)&num_entries, sizeof(uint32_t));
+			file.write((const char*)entries.data(), entries.size()*sizeof(std::pair<uint32_t,uint32_t>));
+		}
+		else {
+			for (unsigned e=0; e<entries.size(); e++) {
+				file << c << "," << entries[e].first << "," << entries[e].second << "\n";
+			}
+		}
+	}
+	file.close();
+}
+
+//////////////////////////////////
+// Function to write the miss-ratio curves to a CSV file (lines with 'curve,ways,
+// lines,miss_rate'). The 'full' curve is the miss rate of a fully-associative cache
+// of every capacity in lines (from case 1, distances[1]). The 'set' curve is the
+// miss rate for every number of ways per set, keeping the number of sets fixed
+// (from case 0, distances[0]). Both cases are timed runs: their distances include
+// the latencies and the MSHRs as modelled for the configured cache, so the curves
+// are exact at the configured capacity and approximate at other capacities (whose
+// hits and misses would change the timing).
+//////////////////////////////////
+void output_mrc(const Result &result,
+                const std::string kernelname,
+                const std::string benchname,
+                const Settings hardware) {
+	std::vector<float> full_curve = miss_ratio_curve(result.distances[1]);
+	std::vector<float> set_curve = miss_ratio_curve(result.distances[0]);
+	std::ofstream file(output_dir+"/"+benchname+"/"+kernelname+"_mrc.csv");
+	file << "curve,ways,lines,miss_rate" << std::endl;
+	for (unsigned c=0; c<full_curve.size(); c++) {
+		file << "full," << (c+1) << "," << (c+1) << "," << full_curve[c] << "\n";
+	}
+	for (unsigned c=0; c<set_curve.size(); c++) {
+		file << "set," << (c+1) << "," << (c+1)*hardware.cache_sets << "," << set_curve[c] << "\n";
+	}
+	file.close();
+}
+
+//////////////////////////////////
+// Function to write the profile per instruction slot as two CSV files: the
+// accesses, misses and miss rate of each slot (lines with 'slot,cache,accesses,
+// misses,miss_rate,instruction') and the histograms of each slot (lines with
+// 'slot,cache,distance,frequency', infinite distances as 99999999). The cache is
+// 0 for the L1, 1 for the texture and 2 for the constant cache. The instruction is
+// only known if the tracer wrote it (see 'read_slot_instructions').
+//////////////////////////////////
+void output_slots(const std::vector<ProfileStats> &statistics,
+                  const std::vector<std::string> &instructions,
+                  const Result &result,
+                  const std::string kernelname,
+                  const std::string benchname) {
+	std::ofstream file(output_dir+"/"+benchname+"/"+kernelname+"_slots.csv");
+	file << "slot,cache,accesses,misses,miss_rate,instruction" << std::endl;
+	for (unsigned s=0; s<statistics.size(); s++) {
+		const ProfileStats &stats = statistics[s];
+		file << stats.index << "," << stats.cache << "," << stats.accesses << "," << stats.misses << ","
+		     << 100*stats.misses/(float)stats.accesses << ",\"" << ((stats.index < instructions.size()) ? instructions[stats.index] : "") << "\"\n";
+	}
+	file.close();
+	std::ofstream histogram_file(output_dir+"/"+benchname+"/"+kernelname+"_slot_histograms.csv");
+	histogram_file << "slot,cache,distance,frequency" << std::endl;
+	std::vector<std::pair<unsigned long,unsigned>> entries = result.slots.sorted();
+	for (unsigned e=0; e<entries.size(); e++) {
+		histogram_file << AccessProfile::get_index(entries[e].first) << "," << AccessProfile::get_cache(entries[e].first) << ","
+		               << AccessProfile::get_distance(entries[e].first) << "," << entries[e].second << "\n";
+	}
+	histogram_file.close();
+}
+
+//////////////////////////////////
+// Function to read the instructions of the slots as written by the tracer: a line
+// per memory access of the first thread, with its type (as in the trace), the PTX
+// program counter and the PTX instruction. Stores are skipped unless they are
+// modelled, such that the instructions line up with the slots. Returns an empty
+// list if the file does not exist.
+//////////////////////////////////
+std::vector<std::string> read_slot_instructions(const std::string filename,
+                                                bool keep_stores) {
+	std::vector<std::string> instructions;
+	std::ifstream input_file(filename);
+	unsigned direction;
+	std::string pc, instruction;
+	while (input_file >> direction >> pc && std::getline(input_file, instruction)) {
+		if (direction != 1 || keep_stores) {
+			size_t start = instruction.find_first_not_of(" \t");
+			instructions.push_back(pc+": "+((start == std::string::npos) ? "" : instruction.substr(start)));
+		}
+	}
+	return instructions;
+}
+
+//////////////////////////////////
+// Function to write the accesses and misses per buffer as two CSV files (as for
+// the slots): the statistics of each buffer (lines with 'buffer,base,bytes,cache,
+// accesses,misses,miss_rate') and the histograms of each buffer (lines with
+// 'buffer,cache,distance,frequency'). Accesses outside all buffers are attributed
+// to the buffer '(other)'.
+//////////////////////////////////
+void output_buffers(const std::vector<ProfileStats> &statistics,
+                    const std::vector<Buffer> &buffer_list,
+                    const Result &result,
+                    const std::string kernelname,
+                    const std::string benchname) {
+	Buffer other = { "(other)", 0, 0 };
+	std::ofstream file(output_dir+"/"+benchname+"/"+kernelname+"_buffers.csv");
+	file << "buffer,base,bytes,cache,accesses,misses,miss_rate" << std::endl;
+	for (unsigned s=0; s<statistics.size(); s++) {
+		const ProfileStats &stats = statistics[s];
+		const Buffer &buffer = (stats.index < buffer_list.size()) ? buffer_list[stats.index] : other;
+		file << buffer.name << "," << buffer.base << "," << buffer.bytes << "," << stats.cache << "," << stats.accesses << ","
+		     << stats.misses << "," << 100*stats.misses/(float)stats.accesses << "\n";
+	}
+	file.close();
+	std::ofstream histogram_file(output_dir+"/"+benchname+"/"+kernelname+"_buffer_histograms.csv");
+	histogram_file << "buffer,cache,distance,frequency" << std::endl;
+	std::vector<std::pair<unsigned long,unsigned>> entries = result.buffers.sorted();
+	for (unsigned e=0; e<entries.size(); e++) {
+		unsigned index = AccessProfile::get_index(entries[e].first);
+		histogram_file << ((index < buffer_list.size()) ? buffer_list[index].name : other.name) << "," << AccessProfile::get_cache(entries[e].first) << ","
+		               << AccessProfile::get_distance(entries[e].first) << "," << entries[e].second << "\n";
+	}
+	histogram_file.close();
+}
+
+//////////////////////////////////
+// Helper function to parse an address or a size of a buffer map (decimal, or
+// hexadecimal with '0x'). Throws a runtime error if it is not a number as a whole.
+//////////////////////////////////
+unsigned long parse_address(const std::string text,
+                            const std::string filename) {
+	char* end = 0;
+	errno = 0;
+	unsigned long value = strtoul(text.c_str(),&end,0);
+	if (errno != 0 || end == text.c_str() || *end != '\0' || text[0] == '-') {
+		throw std::runtime_error("invalid number '"+text+"' in buffer map '"+filename+"'");
+	}
+	return value;
+}
+
+//////////////////////////////////
+// Function to read the address ranges of buffers from a file, containing lines
+// with a name, a base address and a size in bytes (decimal, or hexadecimal with
+// '0x'; lines starting with '#' are comments). Throws a runtime error if the
+// file is missing or invalid.
+//////////////////////////////////
+std::vector<Buffer> read_buffers(const std::string filename) {
+	std::vector<Buffer> buffers;
+	std::ifstream input_file(filename);
+	if (!input_file) {
+		throw std::runtime_error("could not read buffer map '"+filename+"'");
+	}
+	std::string line;
+	while (std::getline(input_file, line)) {
+		std::istringstream line_stream(line);
+		std::string name, base, bytes;
+		if (line.find_first_not_of(" \t") == std::string::npos || line[line.find_first_not_of(" \t")] == '#') { continue; }
+		if (!(line_stream >> name >> base >> bytes)) {
+			throw std::runtime_error("invalid line '"+line+"' in buffer map '"+filename+"'");
+		}
+		buffers.push_back(Buffer({name,parse_address(base,filename),parse_address(bytes,filename)}));
+	}
+	return buffers;
 }
 
 //////////////////////////////////
 // Read the verifier output (from hardware execution) and display the results
 //////////////////////////////////
 void verify_miss_rate(const std::string kernelname,
-                      const std::string benchname) {
+                      const std::string benchname,
+                      const Options options) {
+	std::ostream &out = *options.output;
 	std::string filename = output_dir+"/"+benchname+"/"+kernelname+".prof";
 	
 	// Test if the file exists
 	std::ifstream exists_file(filename);
 	if (!exists_file) {
-		message("No verifier data information available, skipping verification");
+		message(out, "No verifier data information available, skipping verification");
 		return;
 	}
 	
@@ -251,12 +736,12 @@ void verify_miss_rate(const std::string kernelname,
 	file << std::endl;
 	
 	// Output verification data to stdout
-	message("Cache miss rate according to verification data:");
+	message(out, "Cache miss rate according to verification data:");
 	float miss_rate = 100*miss/(double)(miss+hit);
-	std::cout << "### \t Total accesses: " << (miss+hit) << std::endl;
-	std::cout << "### \t Misses: " << miss << std::endl;
-	std::cout << "### \t Hits: " << hit << std::endl;
-	std::cout << "### \t Miss rate: " << miss_rate << "%" << std::endl;
+	out << "### \t Total accesses: " << (miss+hit) << std::endl;
+	out << "### \t Misses: " << miss << std::endl;
+	out << "### \t Hits: " << hit << std::endl;
+	out << "### \t Miss rate: " << miss_rate << "%" << std::endl;
 	
 	// Output verification data to file
 	file << "verified_misses: " << miss << std::endl;
@@ -268,52 +753,375 @@ void verify_miss_rate(const std::string kernelname,
 }
 
 //////////////////////////////////
-// Function to read the hardware settings from a file
+// Function to read a histogram of memory latencies from a file, containing lines
+// with a latency and its frequency (lines starting with '#' are comments). The
+// histogram is returned sorted by latency.
+//////////////////////////////////
+std::vector<std::pair<unsigned,unsigned>> read_latency_histogram(const std::string filename) {
+	std::vector<std::pair<unsigned,unsigned>> histogram;
+	std::ifstream input_file(filename);
+	if (!input_file) {
+		throw std::runtime_error("could not read latency histogram '"+filename+"'");
+	}
+	std::string line;
+	while (std::getline(input_file, line)) {
+		std::istringstream line_stream(line);
+		unsigned latency, frequency;
+		if (line.find_first_not_of(" \t") == std::string::npos || line[line.find_first_not_of(" \t")] == '#') { continue; }
+		if (!(line_stream >> latency >> frequency)) {
+			throw std::runtime_error("invalid line '"+line+"' in latency histogram '"+filename+"'");
+		}
+		histogram.push_back(std::make_pair(latency,frequency));
+	}
+	if (histogram.size() == 0) {
+		throw std::runtime_error("empty latency histogram '"+filename+"'");
+	}
+	std::sort(histogram.begin(), histogram.end());
+	return histogram;
+}
+
+//////////////////////////////////
+// Function to get the default hardware settings (Fermi with a 16KB L1 cache).
+// The cache's lines and sets are computed by 'finalise_settings'.
+//////////////////////////////////
+Settings default_settings(void) {
+	Settings hardware = {
+	  128,                        // line_size
+	  16384,                      // cache_bytes
+	  0,                          // cache_lines
+	  4,                          // cache_ways
+	  0,                          // cache_sets
+	  64,                         // num_mshr
+	  NUM_CORES,                  // num_cores
+	  WARP_SIZE,                  // warp_size
+	  MAX_ACTIVE_THREADS,         // max_active_threads
+	  MAX_ACTIVE_BLOCKS,          // max_active_blocks
+	  100,                        // mem_latency
+	  5,                          // mem_latency_stddev
+	  NON_MEM_LATENCY,            // non_mem_latency
+	  MAPPING_TYPE,               // mapping_type
+	  WARP_SCHEDULER,             // warp_scheduler
+	  SCHEDULER_GROUP_SIZE,       // scheduler_group_size
+	  L2_BYTES,                   // l2_bytes
+	  L2_WAYS,                    // l2_ways
+	  L2_BANKS,                   // l2_banks
+	  WRITE_POLICY,               // write_policy
+	  TEX_BYTES,                  // tex_bytes
+	  TEX_WAYS,                   // tex_ways
+	  CONST_BYTES,                // const_bytes
+	  CONST_WAYS,                 // const_ways
+	  SECTOR_SIZE,                // sector_size
+	  0,                          // l2_sets
+	  0,                          // tex_sets
+	  0                           // const_sets
+	};
+	return hardware;
+}
+
+//////////////////////////////////
+// The keys of the hardware settings (as used in the configuration files) and
+// the corresponding fields in the settings data-structure
+//////////////////////////////////
+const SettingKey SETTING_KEYS[NUM_SETTING_KEYS] = {
+	{ "LINE_SIZE",            &Settings::line_size },
+	{ "CACHE_BYTES",          &Settings::cache_bytes },
+	{ "CACHE_WAYS",           &Settings::cache_ways },
+	{ "NUM_MSHR",             &Settings::num_mshr },
+	{ "MEM_LATENCY",          &Settings::mem_latency },
+	{ "MEM_LATENCY_STDDEV",   &Settings::mem_latency_stddev },
+	{ "NUM_CORES",            &Settings::num_cores },
+	{ "WARP_SIZE",            &Settings::warp_size },
+	{ "MAX_ACTIVE_THREADS",   &Settings::max_active_threads },
+	{ "MAX_ACTIVE_BLOCKS",    &Settings::max_active_blocks },
+	{ "NON_MEM_LATENCY",      &Settings::non_mem_latency },
+	{ "MAPPING_TYPE",         &Settings::mapping_type },
+	{ "WARP_SCHEDULER",       &Settings::warp_scheduler },
+	{ "SCHEDULER_GROUP_SIZE", &Settings::scheduler_group_size },
+	{ "L2_BYTES",             &Settings::l2_bytes },
+	{ "L2_WAYS",              &Settings::l2_ways },
+	{ "L2_BANKS",             &Settings::l2_banks },
+	{ "WRITE_POLICY",         &Settings::write_policy },
+	{ "TEX_BYTES",            &Settings::tex_bytes },
+	{ "TEX_WAYS",             &Settings::tex_ways },
+	{ "CONST_BYTES",          &Settings::const_bytes },
+	{ "CONST_WAYS",           &Settings::const_ways },
+	{ "SECTOR_SIZE",          &Settings::sector_size }
+};
+
+//////////////////////////////////
+// Function to set a single hardware setting given its key (as used in the con-
+// figuration files). Returns false if the key is unknown.
+//////////////////////////////////
+bool set_setting(Settings &hardware,
+                 const std::string key,
+                 unsigned value) {
+	for (unsigned k=0; k<NUM_SETTING_KEYS; k++) {
+		if (key == SETTING_KEYS[k].name) {
+			hardware.*(SETTING_KEYS[k].field) = value;
+			return true;
+		}
+	}
+	return false;
+}
+
+//////////////////////////////////
+// Function to compute the derived hardware settings and to check the settings
+// for validity. Returns an error message, or an empty string if all is fine.
+//////////////////////////////////
+std::string finalise_settings(Settings &hardware) {
+	if (hardware.line_size == 0 || hardware.cache_ways == 0 || hardware.warp_size == 0 ||
+	    hardware.num_cores == 0 || hardware.max_active_blocks == 0) {
+		return "LINE_SIZE, CACHE_WAYS, WARP_SIZE, NUM_CORES and MAX_ACTIVE_BLOCKS should be non-zero";
+	}
+	if (hardware.cache_bytes < hardware.line_size*hardware.cache_ways) {
+		return "CACHE_BYTES should be at least LINE_SIZE*CACHE_WAYS";
+	}
+	if (hardware.mapping_type > 2) {
+		return "MAPPING_TYPE should be 0 (modulo), 1 (XOR) or 2 (Fermi)";
+	}
+	if (hardware.warp_scheduler > 2) {
+		return "WARP_SCHEDULER should be 0 (LRR), 1 (GTO) or 2 (two-level)";
+	}
+	if (hardware.scheduler_group_size == 0) {
+		return "SCHEDULER_GROUP_SIZE should be non-zero";
+	}
+	if (hardware.write_policy > 2) {
+		return "WRITE_POLICY should be 0 (stores not cached), 1 (write-through) or 2 (write-back)";
+	}
+	if (hardware.l2_bytes > 0 && (hardware.l2_ways == 0 || hardware.l2_banks == 0 ||
+	                              hardware.l2_bytes < hardware.line_size*hardware.l2_ways*hardware.l2_banks)) {
+		return "L2_BYTES should be at least LINE_SIZE*L2_WAYS*L2_BANKS (with non-zero L2_WAYS and L2_BANKS)";
+	}
+	if (hardware.tex_bytes > 0 && (hardware.tex_ways == 0 || hardware.tex_bytes < hardware.line_size*hardware.tex_ways)) {
+		return "TEX_BYTES should be at least LINE_SIZE*TEX_WAYS (with non-zero TEX_WAYS)";
+	}
+	if (hardware.const_bytes > 0 && (hardware.const_ways == 0 || hardware.const_bytes < hardware.line_size*hardware.const_ways)) {
+		return "CONST_BYTES should be at least LINE_SIZE*CONST_WAYS (with non-zero CONST_WAYS)";
+	}
+	if (hardware.sector_size > 0 && (hardware.line_size % hardware.sector_size != 0 || hardware.line_size/hardware.sector_size > 32)) {
+		return "SECTOR_SIZE should divide LINE_SIZE into at most 32 sectors (or be 0)";
+	}
+	hardware.cache_lines = hardware.cache_bytes/hardware.line_size;
+	hardware.cache_sets = hardware.cache_bytes/(hardware.line_size*hardware.cache_ways);
+	hardware.l2_sets = (hardware.l2_bytes > 0) ? hardware.l2_bytes/(hardware.line_size*hardware.l2_ways*hardware.l2_banks) : 0;
+	hardware.tex_sets = (hardware.tex_bytes > 0) ? hardware.tex_bytes/(hardware.line_size*hardware.tex_ways) : 0;
+	hardware.const_sets = (hardware.const_bytes > 0) ? hardware.const_bytes/(hardware.line_size*hardware.const_ways) : 0;
+	return "";
+}
+
+//////////////////////////////////
+// Function to read the hardware settings from a file and to apply the overrides
+// given on the command-line. The file contains 'KEY value' pairs in any order
+// (lines starting with '#' are comments). Keys which are not given keep their
+// default value.
 //////////////////////////////////
-Settings get_settings(void) {
-	std::string filename = config_dir+"/"+"current.conf";
+Settings get_settings(const Options options) {
+	std::string filename = options.config_file;
+	Settings hardware = default_settings();
 	
 	// Test if the file exists
-	std::ifstream exists_file(filename);
-	if (!exists_file) {
+	std::ifstream input_file(filename);
+	if (!input_file) {
 		std::cout << "### Error: could not read settings file '" << filename << "'" << std::endl;
 		message("");
-		exit(0);
+		exit(1);
 	}
 	
-	// Open the settings file for reading
-	std::ifstream input_file(filename);
-	
 	// Then proceed to the parse the data
-	std::string identifier;
-	unsigned line_size, cache_bytes, cache_ways, num_mshr, mem_latency, mem_latency_stddev;
-	input_file >> identifier >> line_size;
-	input_file >> identifier >> cache_bytes;
-	input_file >> identifier >> cache_ways;
-	input_file >> identifier >> num_mshr;
-	input_file >> identifier >> mem_latency;
-	input_file >> identifier >> mem_latency_stddev;
-	
-	// Store the data in the settings data-structure
-	Settings hardware = {
-	  line_size,
-	  cache_bytes,
-	  cache_bytes/line_size,
-	  cache_ways,
-	  cache_bytes/(line_size*cache_ways),
-	  num_mshr,
-	  NUM_CORES,
-	  WARP_SIZE,
-	  MAX_ACTIVE_THREADS,
-	  MAX_ACTIVE_BLOCKS,
-	  mem_latency,
-	  mem_latency_stddev
-	};
+	std::string line;
+	while (std::getline(input_file, line)) {
+		std::istringstream line_stream(line);
+		std::string key;
+		unsigned value;
+		if (!(line_stream >> key) || key[0] == '#') { continue; }
+		if (!(line_stream >> value) || !set_setting(hardware, key, value)) {
+			std::cout << "### Error: invalid setting '" << line << "' in '" << filename << "'" << std::endl;
+			message("");
+			exit(1);
+		}
+	}
 	
-	// Close the file and return
+	// Apply the command-line overrides (given as KEY=value, the value being digits only)
+	for (unsigned i=0; i<options.overrides.size(); i++) {
+		std::string override = options.overrides[i];
+		size_t split = override.find('=');
+		std::string text = (split != std::string::npos) ? override.substr(split+1) : "";
+		std::istringstream value_stream(text);
+		unsigned value;
+		bool valid = (text != "" && text.find_first_not_of("0123456789") == std::string::npos && (value_stream >> value));
+		if (!valid || !set_setting(hardware, override.substr(0,split), value)) {
+			std::cout << "### Error: invalid setting override '" << override << "'" << std::endl;
+			message("");
+			exit(1);
+		}
+	}
+	
+	// Compute the number of cache lines and sets and check for errors
+	std::string error = finalise_settings(hardware);
+	if (error != "") {
+		std::cout << "### Error: " << error << std::endl;
+		message("");
+		exit(1);
+	}
 	return hardware;
 }
 
+//////////////////////////////////
+// Function to get the default model options (exact, serial and verbose)
+//////////////////////////////////
+Options default_options(void) {
+	Options options = { 1, 1.0, SAMPLE_MODULUS, true, config_dir+"/"+"current.conf", std::vector<std::string>(), 0, true, &std::cout, 0, true, "", DEFAULT_SEED, 1, false, "", false, BANDWIDTH_WINDOW, false, "", 0 };
+	return options;
+}
+
+//////////////////////////////////
+// Function to parse the model options from the command-line arguments, starting
+// at argument 'first' (the preceding arguments, e.g. the benchmark name, are
+// skipped here)
+//////////////////////////////////
+Options get_options(int argc, char** argv, int first) {
+	Options options = default_options();
+	for (int i=first; i<argc; i++) {
+		std::string argument = argv[i];
+		
+		// Number of worker threads for the set-parallel mode
+		if (argument == "--workers" && i+1 < argc) {
+			options.num_workers = std::max(1,atoi(argv[++i]));
+		}
+		
+		// Fraction of cache-lines to sample in the approximate mode
+		else if (argument == "--sample-rate" && i+1 < argc) {
+			options.sample_rate = atof(argv[++i]);
+			if (options.sample_rate <= 0 || options.sample_rate > 1) {
+				message("Error: the sample rate should be in the range (0,1]");
+				message("");
+				exit(1);
+			}
+			options.sample_threshold = (unsigned)std::round(options.sample_rate*SAMPLE_MODULUS);
+		}
+		
+		// Number of kernels (or configurations in a sweep) to model concurrently
+		else if (argument == "--jobs" && i+1 < argc) {
+			options.num_jobs = std::max(1,atoi(argv[++i]));
+		}
+		
+		// Memory budget (in MB) for modelling kernels concurrently
+		else if (argument == "--memory-budget" && i+1 < argc) {
+			options.memory_budget = std::max(1,atoi(argv[++i]));
+		}
+		
+		// Always keep the accesses in memory (do not spill large kernels to a file)
+		else if (argument == "--no-spill") {
+			options.spill = false;
+		}
+		
+		// Histogram of memory latencies to draw the latencies of misses from
+		else if (argument == "--latency-histogram" && i+1 < argc) {
+			options.latency_file = argv[++i];
+			try {
+				read_latency_histogram(options.latency_file);
+			}
+			catch (std::exception &e) {
+				std::cout << "### Error: " << e.what() << std::endl;
+				message("");
+				exit(1);
+			}
+		}
+		
+		// Seed for all randomness in the model
+		else if (argument == "--seed" && i+1 < argc) {
+			options.seed = strtoul(argv[++i], 0, 10);
+		}
+		
+		// Number of seeds to model (to report the mean and variance of the miss rate)
+		else if (argument == "--seeds" && i+1 < argc) {
+			options.num_seeds = std::max(1,atoi(argv[++i]));
+		}
+		
+		// Write a summary of the results as JSON
+		else if (argument == "--json") {
+			options.json_output = true;
+		}
+		
+		// Write the histograms of all cases as CSV or as binary
+		else if (argument == "--histograms" && i+1 < argc) {
+			options.histogram_format = argv[++i];
+			if (options.histogram_format != "csv" && options.histogram_format != "bin") {
+				std::cout << "### Error: unknown histogram format '" << options.histogram_format << "' (use 'csv' or 'bin')" << std::endl;
+				message("");
+				exit(1);
+			}
+		}
+		
+		// Write the miss-ratio curves
+		else if (argument == "--mrc") {
+			options.mrc_output = true;
+		}
+		
+		// Size of the time windows (in cycles) to measure the peak bandwidth demand
+		else if (argument == "--bandwidth-window" && i+1 < argc) {
+			options.bandwidth_window = std::max(1,atoi(argv[++i]));
+		}
+		
+		// Profile the accesses and misses per instruction slot
+		else if (argument == "--slots") {
+			options.slot_output = true;
+		}
+		
+		// Address ranges of the buffers to attribute the accesses and misses to (a file, or
+		// 'trace' for the buffers captured by the tracer for each kernel)
+		else if (argument == "--buffers" && i+1 < argc) {
+			options.buffer_file = argv[++i];
+			try {
+				if (options.buffer_file != BUFFERS_FROM_TRACE) { options.buffer_map = std::make_shared<const BufferMap>(read_buffers(options.buffer_file)); }
+			}
+			catch (std::exception &e) {
+				std::cout << "### Error: " << e.what() << std::endl;
+				message("");
+				exit(1);
+			}
+		}
+		
+		// Always recompute the results (do not use the result cache)
+		else if (argument == "--no-cache") {
+			options.use_cache = false;
+		}
+		
+		// Configuration file to read the hardware settings from
+		else if (argument == "--config" && i+1 < argc) {
+			options.config_file = argv[++i];
+		}
+		
+		// Override of a single hardware setting (KEY=value)
+		else if (argument == "--set" && i+1 < argc) {
+			options.overrides.push_back(argv[++i]);
+		}
+		
+		// Unknown argument
+		else {
+			std::cout << "### Error: unknown or incomplete option '" << argument << "'" << std::endl;
+			message("");
+			exit(1);
+		}
+	}
+	return options;
+}
+
+//////////////////////////////////
+// Helper functions to compute the mean and the (sample) variance of a list of values
+//////////////////////////////////
+double mean(const std::vector<float> &values) {
+	double sum = 0;
+	for (unsigned i=0; i<values.size(); i++) { sum += values[i]; }
+	return (values.size() > 0) ? sum/values.size() : 0;
+}
+double variance(const std::vector<float> &values) {
+	double average = mean(values);
+	double sum = 0;
+	for (unsigned i=0; i<values.size(); i++) { sum += (values[i]-average)*(values[i]-average); }
+	return (values.size() > 1) ? sum/(values.size()-1) : 0;
+}
+
 //////////////////////////////////
 // Helper function to print messages to stdout
 //////////////////////////////////
@@ -322,3 +1130,10 @@ void message(std::string x) {
 }
 
 //////////////////////////////////
+// Helper function to print messages to a given stream
+//////////////////////////////////
+void message(std::ostream &out, std::string x) {
+	out << "### " << x << std::endl;
+}
+
+//////////////////////////////////
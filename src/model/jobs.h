@@ -0,0 +1,93 @@
+//////////////////////////////////
+//
+// == A reuse distance based GPU cache model
+// This file is part of a cache model for GPUs. The cache model is based on
+// reuse distance theory extended to work with GPUs. The cache model primarly
+// focusses on modelling NVIDIA's Fermi architecture.
+//
+// == More information on the GPU cache model
+// Article............A Detailed GPU Cache Model Based on Reuse Distance Theory
+// Authors............C. Nugteren et al.
+//
+// == Contents of this file
+// This particular file implements a work-stealing pool of worker threads to
+// run independent jobs (e.g. the configurations of a sweep). The jobs are given
+// as indices and are initially divided in contiguous ranges over the workers,
+// such that neighbouring jobs (which typically share data) stay on the same
+// worker. A worker takes jobs from the front of its own queue and, once it runs
+// out of work, steals jobs from the back of the queues of the other workers.
+//
+// == File details
+// Filename...........src/model/jobs.h
+// Author.............Cedric Nugteren <www.cedricnugteren.nl>
+// Affiliation........Eindhoven University of Technology, The Netherlands
+// Last modified on...16-Oct-2026
+//
+//////////////////////////////////
+
+#ifndef JOBS_H
+#define JOBS_H
+
+// C++ headers
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <functional>
+
+//////////////////////////////////
+// The work-stealing pool
+//////////////////////////////////
+class JobPool {
+	std::vector<std::deque<unsigned>> queues; // Queue of jobs for each worker
+	std::vector<std::mutex> locks;            // Lock for each queue
+	
+	// Take a job from the front of a worker's own queue, or steal one from the back
+	// of another worker's queue. Returns false if there is no work left at all.
+	bool get_job(unsigned worker, unsigned &job) {
+		for (unsigned i=0; i<queues.size(); i++) {
+			unsigned victim = (worker+i) % queues.size();
+			std::lock_guard<std::mutex> guard(locks[victim]);
+			if (!queues[victim].empty()) {
+				if (i == 0) { job = queues[victim].front(); queues[victim].pop_front(); }
+				else {        job = queues[victim].back();  queues[victim].pop_back(); }
+				return true;
+			}
+		}
+		return false;
+	}
+
+// Public functions
+public:
+
+	// Initialise the pool with a number of workers
+	JobPool(unsigned num_workers) :
+		queues(std::max(1u,num_workers)),
+		locks(std::max(1u,num_workers)) {
+	}
+	
+	// Run 'num_jobs' jobs and wait for their completion. The job function is called
+	// with the index of the worker (to select per-worker data) and of the job.
+	void run(unsigned num_jobs, std::function<void(unsigned,unsigned)> job_function) {
+		unsigned num_workers = queues.size();
+		for (unsigned job=0; job<num_jobs; job++) {
+			queues[(job*(unsigned long)num_workers)/num_jobs].push_back(job);
+		}
+		std::vector<std::thread> workers;
+		for (unsigned w=0; w<num_workers; w++) {
+			workers.push_back(std::thread([this,w,&job_function]() {
+				unsigned job;
+				while (get_job(w,job)) {
+					job_function(w,job);
+				}
+			}));
+		}
+		for (unsigned w=0; w<num_workers; w++) {
+			workers[w].join();
+		}
+	}
+};
+
+//////////////////////////////////
+
+#endif
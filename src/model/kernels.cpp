@@ -0,0 +1,235 @@
+//////////////////////////////////
+//
+// == A reuse distance based GPU cache model
+// This file is part of a cache model for GPUs. The cache model is based on
+// reuse distance theory extended to work with GPUs. The cache model primarly
+// focusses on modelling NVIDIA's Fermi architecture.
+//
+// == More information on the GPU cache model
+// Article............A Detailed GPU Cache Model Based on Reuse Distance Theory
+// Authors............C. Nugteren et al.
+//
+// == Contents of this file
+// This particular file implements the modelling of all kernels of a benchmark.
+// The kernels' traces are discovered up-front, after which the (independent)
+// kernels are modelled concurrently by a pool of workers (see src/model/jobs.h).
+// The number of kernels in flight is bounded by a memory budget, based on an
+// estimate of each kernel's memory use. The output of each kernel is buffered
+// and printed in the order of the kernels, such that the output is the same as
+// when the kernels are modelled one after another.
+//
+// == File details
+// Filename...........src/model/kernels.cpp
+// Author.............Cedric Nugteren <www.cedricnugteren.nl>
+// Affiliation........Eindhoven University of Technology, The Netherlands
+// Last modified on...16-Oct-2026
+//
+//////////////////////////////////
+
+// Include the header file
+#include "model.h"
+
+// System headers (to find the size of the physical memory and the memory use)
+#include <unistd.h>
+#include <sys/resource.h>
+
+// Global settings for the directory structure (see src/model/io.cpp)
+extern std::string output_dir;
+
+//////////////////////////////////
+// Function to find the kernels of a benchmark: the traces are numbered from 0
+// onwards ('benchname_00.trc', 'benchname_01.trc', ...) without gaps
+//////////////////////////////////
+std::vector<std::string> find_kernels(const std::string benchname) {
+	std::vector<std::string> kernelnames;
+	for (unsigned kernel_id = 0; true; kernel_id++) {
+	
+		// Set the kernelname and include a counter
+		std::string kernelname;
+		if (kernel_id < 10) { kernelname = benchname+"_0"+std::to_string(kernel_id); }
+		else {                kernelname = benchname+"_" +std::to_string(kernel_id); }
+		
+		// The final tracefile is found, exit the loop
+		std::ifstream exists_file(output_dir+"/"+benchname+"/"+kernelname+".trc");
+		if (!exists_file) { break; }
+		kernelnames.push_back(kernelname);
+	}
+	return kernelnames;
+}
+
+//////////////////////////////////
+// Function to get the memory budget (in bytes): as given in the options, or by
+// default half of the physical memory
+//////////////////////////////////
+size_t get_memory_budget(const Options options) {
+	if (options.memory_budget != 0) { return (size_t)options.memory_budget*1024*1024; }
+	return (size_t)sysconf(_SC_PHYS_PAGES)*(size_t)sysconf(_SC_PAGE_SIZE)/2;
+}
+
+//////////////////////////////////
+// Function to get the peak memory use of the process so far (in bytes)
+//////////////////////////////////
+size_t get_peak_memory(void) {
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return (size_t)usage.ru_maxrss*1024;
+}
+
+//////////////////////////////////
+// Function to estimate the memory use of modelling a trace (in bytes) from the
+// size of the trace file
+//////////////////////////////////
+size_t estimate_trace_memory(const std::string filename) {
+	std::ifstream input_file(filename, std::ios::binary|std::ios::ate);
+	size_t trace_bytes = (input_file) ? (size_t)input_file.tellg() : 0;
+	return KERNEL_MEMORY_FACTOR*trace_bytes + KERNEL_MEMORY_BASE;
+}
+
+//////////////////////////////////
+// Function to estimate the memory use of modelling a kernel (in bytes)
+//////////////////////////////////
+size_t estimate_kernel_memory(const std::string kernelname,
+                              const std::string benchname) {
+	return estimate_trace_memory(output_dir+"/"+benchname+"/"+kernelname+".trc");
+}
+
+//////////////////////////////////
+// Function to model a single kernel (or to load its results from the cache) and
+// to output the results. Progress information and results are printed to the
+// stream given in the options.
+//////////////////////////////////
+void model_kernel(const std::string kernelname,
+                  const std::string benchname,
+                  const Settings hardware,
+                  const Options kernel_options) {
+	std::ostream &out = *kernel_options.output;
+	
+	// Attribute the accesses to the buffers captured by the tracer (if requested): they
+	// are read once, for the model and for the output
+	Options options = kernel_options;
+	if (options.buffer_file == BUFFERS_FROM_TRACE) {
+		options.buffer_file = output_dir+"/"+benchname+"/"+kernelname+".buffers";
+		try {
+			options.buffer_map = std::make_shared<const BufferMap>(read_buffers(options.buffer_file));
+		}
+		catch (std::exception &e) {
+			out << "### Error: " << e.what() << std::endl;
+			return;
+		}
+	}
+	
+	// Re-use the results of an earlier run if neither the trace nor the configuration changed
+	Result result;
+	std::string cache_key = (options.use_cache && options.num_seeds <= 1) ? get_cache_key(kernelname, benchname, hardware, options) : "";
+	if (cache_key != "" && load_cached_result(cache_key, hardware, options, result)) {
+		out << SPLIT_STRING << std::endl;
+		message(out, "");
+		out << "### Found cached results for '" << kernelname << "'" << std::endl;
+	}
+	else {
+		Kernel kernel;
+		kernel.threads.resize(MAX_THREADS);
+		
+		// Load a memory access trace from a file (an error is printed if it is invalid)
+		Dim3 blockdim = read_file(kernel.threads, kernelname, benchname, options, hardware.write_policy != 0);
+		unsigned blocksize = blockdim.x*blockdim.y*blockdim.z;
+		if (blocksize == 0) { return; }
+		
+		// Assign threads to warps, threadblocks and GPU cores
+		message(out, "");
+		out << "### Assigning threads to warps/blocks/cores...";
+		prepare_kernel(kernel, blockdim, hardware);
+		out << "done" << std::endl;
+		
+		// Compute the reuse distance profiles and the cache misses
+		result = run_model_seeds(kernel, hardware, options);
+		
+		// Store the results in the cache
+		if (cache_key != "") {
+			store_cached_result(cache_key, hardware, result);
+		}
+	}
+	
+	// Output the reuse distance profile and the cache hit/miss rate
+	message(out, "");
+	output_miss_rate(result, kernelname, benchname, hardware, options);
+	
+	// Display the cache hit/miss rate from the output of the verifier (if available)
+	message(out, "");
+	verify_miss_rate(kernelname, benchname, options);
+	message(out, "");
+}
+
+//////////////////////////////////
+// Function to model all the kernels of a benchmark, concurrently if requested.
+// A kernel is only started if its estimated memory use fits in the budget next
+// to the kernels in flight (a single kernel is always allowed to run).
+//////////////////////////////////
+void model_benchmark(const std::vector<std::string> &kernelnames,
+                     const std::string benchname,
+                     const Settings hardware,
+                     const Options options) {
+	unsigned num_kernels = kernelnames.size();
+	unsigned num_workers = options.num_jobs;
+	if (num_workers == 0) { num_workers = std::max(1u,std::thread::hardware_concurrency()); }
+	num_workers = std::min(num_workers, num_kernels);
+	
+	// Model the kernels one after another: print the output directly
+	if (num_workers <= 1) {
+		for (unsigned k=0; k<num_kernels; k++) {
+			model_kernel(kernelnames[k], benchname, hardware, options);
+		}
+		return;
+	}
+	
+	// Set the memory budget (by default half of the physical memory)
+	size_t budget = get_memory_budget(options);
+	
+	// Start with the largest kernels to balance the load over the workers
+	std::vector<std::pair<size_t,unsigned>> order(num_kernels);
+	for (unsigned k=0; k<num_kernels; k++) {
+		order[k] = std::make_pair(estimate_kernel_memory(kernelnames[k], benchname),k);
+	}
+	std::sort(order.rbegin(), order.rend());
+	
+	// Model the kernels concurrently, each with its own output buffer
+	std::vector<std::ostringstream> outputs(num_kernels);
+	std::vector<bool> finished(num_kernels,false);
+	unsigned next_output = 0;
+	size_t memory_in_use = 0;
+	unsigned num_running = 0;
+	std::mutex lock;
+	std::condition_variable memory_freed;
+	JobPool pool(num_workers);
+	pool.run(num_kernels, [&](unsigned w, unsigned j) {
+		size_t memory = order[j].first;
+		unsigned k = order[j].second;
+		
+		// Wait until the kernel fits in the memory budget
+		{
+			std::unique_lock<std::mutex> guard(lock);
+			memory_freed.wait(guard, [&]() { return num_running == 0 || memory_in_use + memory <= budget; });
+			memory_in_use += memory;
+			num_running++;
+		}
+		
+		// Model the kernel
+		Options kernel_options = options;
+		kernel_options.output = &outputs[k];
+		model_kernel(kernelnames[k], benchname, hardware, kernel_options);
+		
+		// Release the memory and print the output of all kernels finished so far (in order)
+		std::lock_guard<std::mutex> guard(lock);
+		memory_in_use -= memory;
+		num_running--;
+		finished[k] = true;
+		while (next_output < num_kernels && finished[next_output]) {
+			*options.output << outputs[next_output].str();
+			outputs[next_output].str("");
+			next_output++;
+		}
+		memory_freed.notify_all();
+	});
+}
+
+//////////////////////////////////
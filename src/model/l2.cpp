@@ -0,0 +1,112 @@
+//////////////////////////////////
+//
+// == A reuse distance based GPU cache model
+// This file is part of a cache model for GPUs. The cache model is based on
+// reuse distance theory extended to work with GPUs. The cache model primarly
+// focusses on modelling NVIDIA's Fermi architecture.
+//
+// == More information on the GPU cache model
+// Article............A Detailed GPU Cache Model Based on Reuse Distance Theory
+// Authors............C. Nugteren et al.
+//
+// == Contents of this file
+// This particular file implements the model of a shared L2 cache. The L1 passes
+// of the modelled cores (see src/model/reusedistance.cpp) each produce a stream
+// of the misses they send to the L2 cache. These streams are interleaved by time
+// and fed to a second reuse distance analysis over the banked L2 cache: cache-
+// lines are interleaved over the banks and each bank is set-associative. Only
+// the miss streams are kept, the full traces of the cores are not stored. The L2
+// cache itself is modelled without latencies and MSHRs.
+//
+// == File details
+// Filename...........src/model/l2.cpp
+// Author.............Cedric Nugteren <www.cedricnugteren.nl>
+// Affiliation........Eindhoven University of Technology, The Netherlands
+// Last modified on...16-Oct-2026
+//
+//////////////////////////////////
+
+// Include the header file
+#include "model.h"
+
+//////////////////////////////////
+// Helper function to map a cache-line address to a set of the L2 cache: the bank
+// is selected by the lowest bits, the set within the bank by the next bits
+//////////////////////////////////
+inline unsigned l2_line_addr_to_set(unsigned long line_addr,
+                                    const Settings &hardware) {
+	unsigned bank = line_addr % hardware.l2_banks;
+	unsigned set = (line_addr / hardware.l2_banks) % hardware.l2_sets;
+	return bank*hardware.l2_sets + set;
+}
+
+//////////////////////////////////
+// Function to calculate the reuse distances of the shared L2 cache given the miss
+// streams of the L1 caches of all cores. The streams are merged in order of time
+// (ties in order of the cores). Outputs a histogram in the same format as the L1
+// reuse distance calculation, scaled to the full trace when sampling.
+//////////////////////////////////
+void l2_reuse_distance(const std::vector<MissStream> &streams,
+                       map_type<unsigned,unsigned> &distances,
+                       const Settings hardware,
+                       const Options options,
+                       Arena &arena) {
+	unsigned num_sets = hardware.l2_sets*hardware.l2_banks;
+	
+	// Count the accesses per set to be able to construct the trees
+	std::vector<unsigned> num_total_accesses(num_sets,0);
+	for (unsigned c=0; c<streams.size(); c++) {
+		for (unsigned e=0; e<streams[c].size(); e++) {
+			num_total_accesses[l2_line_addr_to_set(streams[c][e].line_addr,hardware)]++;
+		}
+	}
+	
+	// Create the trees (B), the hash (P) and the set-counters as for the L1 cache
+	std::vector<Tree> B;
+	B.reserve(num_sets);
+	for (unsigned set=0; set<num_sets; set++) {
+		B.emplace_back(num_total_accesses[set]+STACK_EXTRA_SIZE,arena);
+	}
+	line_map_type P(0,line_map_type::hasher(),line_map_type::key_equal(),line_map_type::allocator_type(arena));
+	std::vector<unsigned> set_counters(num_sets,1);
+	
+	// Merge the streams with a heap holding the time of the next miss of each core
+	typedef std::pair<unsigned,unsigned> heap_entry;
+	std::priority_queue<heap_entry,std::vector<heap_entry>,std::greater<heap_entry>> heap;
+	std::vector<unsigned> positions(streams.size(),0);
+	for (unsigned c=0; c<streams.size(); c++) {
+		if (streams[c].size() > 0) {
+			heap.push(std::make_pair(streams[c][0].time,c));
+		}
+	}
+	while (!heap.empty()) {
+		unsigned c = heap.top().second;
+		heap.pop();
+		const MissEvent &event = streams[c][positions[c]];
+		positions[c]++;
+		if (positions[c] < streams[c].size()) {
+			heap.push(std::make_pair(streams[c][positions[c]].time,c));
+		}
+		
+		// Find the reuse distance and remove the previous occurence from the 'stack'
+		unsigned set = l2_line_addr_to_set(event.line_addr,hardware);
+		unsigned distance = INF;
+		if (P[event.line_addr]) {
+			distance = scale_distance(B[set].count(P[event.line_addr]),options);
+			B[set].unset(P[event.line_addr]);
+		}
+		
+		// Put the access on top of the 'stack' and store the reuse distance
+		P[event.line_addr] = set_counters[set];
+		B[set].set(set_counters[set]);
+		set_counters[set]++;
+		distances[distance]++;
+	}
+	
+	// Scale the histogram to the full trace when sampling
+	if (options.sample_rate < 1.0) {
+		scale_histogram(distances, options.sample_rate);
+	}
+}
+
+//////////////////////////////////
@@ -0,0 +1,118 @@
+//////////////////////////////////
+//
+// == A reuse distance based GPU cache model
+// This file is part of a cache model for GPUs. The cache model is based on
+// reuse distance theory extended to work with GPUs. The cache model primarly
+// focusses on modelling NVIDIA's Fermi architecture.
+//
+// == More information on the GPU cache model
+// Article............A Detailed GPU Cache Model Based on Reuse Distance Theory
+// Authors............C. Nugteren et al.
+//
+// == Contents of this file
+// This particular file implements the latency provider: it draws the latencies
+// of cache misses. Instead of sampling a distribution for every miss, a table of
+// latencies is generated up-front, from which samples are drawn with a fast
+// pseudo-random number generator (xorshift64*). Two distributions are provided:
+// a half-normal distribution around the best-case memory latency, and an
+// empirical distribution given as a histogram of latencies. A provider is cheap
+// to copy (the table is shared), and a copy continues with the same sequence of
+// latencies. This is used to give all cases of the model the same latencies.
+//
+// == File details
+// Filename...........src/model/latency.h
+// Author.............Cedric Nugteren <www.cedricnugteren.nl>
+// Affiliation........Eindhoven University of Technology, The Netherlands
+// Last modified on...16-Oct-2026
+//
+//////////////////////////////////
+
+#ifndef LATENCY_H
+#define LATENCY_H
+
+// C++ headers
+#include <vector>
+#include <random>
+#include <memory>
+#include <cmath>
+#include <utility>
+
+//////////////////////////////////
+// Latency provider settings
+//////////////////////////////////
+#define LATENCY_TABLE_BITS 12        // Size of the latency table as a power of 2 (4096 entries)
+
+//////////////////////////////////
+// The latency provider
+//////////////////////////////////
+class LatencyProvider {
+	std::shared_ptr<const std::vector<unsigned>> table; // Pre-generated latency samples
+	unsigned base;                // Latency added to each sample
+	unsigned long state;          // State of the pseudo-random number generator
+
+public:
+
+	// Initialise a half-normal distribution: the best-case latency plus the absolute
+	// value of a normally distributed sample with a given standard deviation
+	LatencyProvider(unsigned mem_latency, unsigned stddev, unsigned long seed) {
+		std::vector<unsigned>* samples = new std::vector<unsigned>(1 << LATENCY_TABLE_BITS,0);
+		if (stddev > 0) {
+			std::mt19937 gen(seed);
+			std::normal_distribution<> distribution(0,stddev);
+			for (unsigned i=0; i<samples->size(); i++) {
+				(*samples)[i] = std::abs(std::round(distribution(gen)));
+			}
+		}
+		table.reset(samples);
+		base = mem_latency;
+		set_seed(seed);
+	}
+	
+	// Initialise an empirical distribution from a histogram of (latency,frequency)
+	// pairs. The table holds the quantiles of the histogram.
+	LatencyProvider(const std::vector<std::pair<unsigned,unsigned>> &histogram, unsigned long seed) {
+		std::vector<unsigned>* samples = new std::vector<unsigned>(1 << LATENCY_TABLE_BITS,0);
+		double total = 0;
+		for (unsigned h=0; h<histogram.size(); h++) {
+			total += histogram[h].second;
+		}
+		unsigned h = 0;
+		double cumulative = (histogram.size() > 0) ? histogram[0].second : 0;
+		for (unsigned i=0; i<samples->size() && histogram.size() > 0; i++) {
+			double quantile = total*(i+0.5)/samples->size();
+			while (cumulative < quantile && h+1 < histogram.size()) {
+				h++;
+				cumulative += histogram[h].second;
+			}
+			(*samples)[i] = histogram[h].first;
+		}
+		table.reset(samples);
+		base = 0;
+		set_seed(seed);
+	}
+	
+	// Restart the sequence of latencies from a given seed
+	void set_seed(unsigned long seed) {
+		state = seed + 0x9E3779B97F4A7C15UL;
+		state = (state ^ (state >> 30)) * 0xBF58476D1CE4E5B9UL;
+		state = (state ^ (state >> 27)) * 0x94D049BB133111EBUL;
+		state = (state ^ (state >> 31)) | 1;
+	}
+	
+	// Generate the next pseudo-random number (xorshift64*)
+	unsigned long next_random() {
+		state ^= state >> 12;
+		state ^= state << 25;
+		state ^= state >> 27;
+		return state * 0x2545F4914F6CDD1DUL;
+	}
+	
+	// Draw the latency of a cache miss
+	unsigned draw() {
+		return base + (*table)[next_random() >> (64 - LATENCY_TABLE_BITS)];
+	}
+};
+
+//////////////////////////////////
+
+#endif
@@ -17,7 +17,16 @@
 // * Access...........struct
 // * Dim3.............struct
 // * Settings.........struct
+// * SettingKey.......struct
+// * Options..........struct
 // * Request..........struct
+// * Geometry.........typedef
+// * SetAccess........struct
+// * Schedule.........struct
+// * Kernel...........struct
+// * Misses...........struct
+// * Timings..........struct
+// * Result...........struct
 // * Thread...........class
 // * Pool.............class
 // * Requests.........class
@@ -44,15 +53,32 @@
 #include <vector>
 #include <set>
 #include <map>
+#include <queue>
 #include <random>
 #include <algorithm>
+#include <bitset>
+#include <numeric>
 #include <cmath>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <tuple>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+#include <cstdint>
 
 // C headers
 #include <assert.h>
+#include <errno.h>
 
 // Custom includes
+#include "arena.h"
 #include "tree.h"
+#include "jobs.h"
+#include "spill.h"
+#include "latency.h"
 
 //////////////////////////////////
 // Unordered map (C++11) is better for performance, but a normal map also works
@@ -60,20 +86,36 @@
 #if __cplusplus <= 199711L
 	#warning Warning: please use a recent C++ standard (e.g. -std=c++0x) for better performance
 	#define map_type std::map
+	typedef std::map<unsigned long,unsigned,std::less<unsigned long>,
+	                 ArenaAllocator<std::pair<const unsigned long,unsigned> > > line_map_type;
 #else
 	#include <unordered_map>
 	#define map_type std::unordered_map
+	typedef std::unordered_map<unsigned long,unsigned,std::hash<unsigned long>,std::equal_to<unsigned long>,
+	                           ArenaAllocator<std::pair<const unsigned long,unsigned>>> line_map_type;
 #endif
 
 //////////////////////////////////
-// Settings
+// Settings (defaults, can be changed in the configuration file or on the command-line)
 //////////////////////////////////
 #define NUM_CORES 1             // Set the amount of cores (SMs) in the GPU
 #define NON_MEM_LATENCY 0       // Set the latency of a cache hit
+#define MAPPING_TYPE 2          // Set the type of address to set mapping (see associativity.cpp)
+#define WARP_SCHEDULER 0        // Set the warp scheduling policy: 0 (LRR), 1 (GTO) or 2 (two-level)
+#define SCHEDULER_GROUP_SIZE 8  // Set the number of warps in the active group of the two-level policy
+#define L2_BYTES 0              // Set the size of the shared L2 cache in bytes (0 = no L2 is modelled)
+#define L2_WAYS 16              // Set the associativity of the L2 cache
+#define L2_BANKS 6              // Set the number of banks of the L2 cache (cache-lines are interleaved)
+#define WRITE_POLICY 0          // Set the write policy: 0 (stores are not cached), 1 (write-through, no-allocate) or 2 (write-back, write-allocate)
+#define TEX_BYTES 12288         // Set the size of the texture cache in bytes (0 = texture loads go to the L1 cache)
+#define TEX_WAYS 4              // Set the associativity of the texture cache
+#define CONST_BYTES 8192        // Set the size of the constant cache in bytes (0 = constant loads go to the L1 cache)
+#define CONST_WAYS 4            // Set the associativity of the constant cache
+#define SECTOR_SIZE 0           // Set the size of a sector in bytes (0 = no sectors, whole cache-lines are transferred)
 #define MAX_THREADS 32*1024     // Set the maximum number of threads supported
 
 //////////////////////////////////
-// Hardware properties
+// Hardware properties (defaults, can be changed as the settings above)
 //////////////////////////////////
 #define WARP_SIZE 32            // The size of a warp in threads
 #define MAX_ACTIVE_THREADS 1536 // Maximum amount of threads active
@@ -85,6 +127,9 @@
 #define DISABLE_WARNINGS        // Disable or enable printing of warnings
 #define WARNING_FACTOR 1.0      // Determine the threshold to print warnings
 #define PRINT_MAX_DISTANCES 10  // Print only the X most interesting distances
+#define PRINT_MAX_SLOTS 5       // Print only the X slots with the most misses
+#define BUFFERS_FROM_TRACE "trace" // Buffer map option to use the buffers captured by the tracer
+#define HISTOGRAM_MAGIC "RDH1"  // Identifier at the start of a binary histogram file
 #define SPLIT_STRING "###################################################"
 
 //////////////////////////////////
@@ -93,12 +138,31 @@
 #define INF 99999999            // Define infinite as a very large number
 #define STACK_EXTRA_SIZE 256    // Extra size of the reuse distance stack
 #define NUM_CASES 4             // Consider 4 cases: 1) normal, 2) full-associativity, 3) no latency, 4) infinite MSHRs
+#define L2_CASE NUM_CASES       // Index of the L2 histogram (after the 4 cases, only if an L2 is modelled)
+#define TEX_CASE (NUM_CASES+1)  // Index of the texture cache histogram (only if texture loads are modelled)
+#define CONST_CASE (NUM_CASES+2) // Index of the constant cache histogram (only if constant loads are modelled)
+#define NUM_HISTOGRAMS (NUM_CASES+3) // Number of histograms if texture or constant loads are modelled
+#define CACHE_L1 0              // Identifier of the L1 cache (global loads and stores)
+#define CACHE_TEX 1             // Identifier of the texture cache
+#define CACHE_CONST 2           // Identifier of the constant cache
+#define ACCESS_TEXTURE 2        // Access type (direction in the trace) of a texture load
+#define ACCESS_CONSTANT 3       // Access type (direction in the trace) of a constant load
+#define SAMPLE_MODULUS 16777216 // Resolution of the cache-line sampling hash (2^24)
+#define SWEEP_KEY_COLUMNS (NUM_SETTING_KEYS+6)  // Number of key columns in the results table of a sweep
+#define SWEEP_NUM_COLUMNS (NUM_SETTING_KEYS+17) // Number of columns in the results table of a sweep
+#define CACHE_VERSION 7         // Version of the result cache format (invalidates older cache-files)
+#define FNV_OFFSET 14695981039346656037UL // Initial value of the 64-bit FNV-1a hash
+#define FNV_PRIME 1099511628211UL         // Multiplier of the 64-bit FNV-1a hash
+#define BANDWIDTH_WINDOW 1000   // Default size of the time windows (in cycles) to measure the peak bandwidth demand
+#define DEFAULT_SEED 42         // Seed used if no seed is given
+#define KERNEL_MEMORY_FACTOR 3  // Estimated memory use of a kernel per byte of its trace file
+#define KERNEL_MEMORY_BASE (16*1024*1024) // Estimated memory use of a kernel independent of its trace
 
 //////////////////////////////////
 // Data-structure to describe a memory access
 //////////////////////////////////
 struct Access {
-	unsigned direction;           // 1 for write, 0 for read
+	unsigned direction;           // 1 for write, 0 for read, 2 for a texture read, 3 for a constant read
 	unsigned long address;        // The byte address of the first byte
 	unsigned width;               // The SIMD/coalescing width of the access
 	unsigned bytes;               // The number of bytes accessed
@@ -130,8 +194,83 @@ struct Settings {
 	unsigned max_active_blocks;   // Maximum active threadblocks in a core (e.g. 8)
 	unsigned mem_latency;         // The best-case off-chip memory latency (e.g. 100)
 	unsigned mem_latency_stddev;  // The standard deviation of the latency (e.g. 5)
+	unsigned non_mem_latency;     // The latency of a cache hit (e.g. 0)
+	unsigned mapping_type;        // Address to set mapping: 0 (modulo), 1 (XOR) or 2 (Fermi's hash)
+	unsigned warp_scheduler;      // Warp scheduling policy: 0 (LRR), 1 (GTO) or 2 (two-level)
+	unsigned scheduler_group_size; // Number of warps in the active group (two-level policy only)
+	unsigned l2_bytes;            // Size of the shared L2 cache in bytes (0 = no L2)
+	unsigned l2_ways;             // Associativity of the L2 cache
+	unsigned l2_banks;            // Number of banks of the L2 cache
+	unsigned write_policy;        // Write policy: 0 (stores not cached), 1 (write-through) or 2 (write-back)
+	unsigned tex_bytes;           // Size of the texture cache in bytes (0 = texture loads go to the L1 cache)
+	unsigned tex_ways;            // Associativity of the texture cache
+	unsigned const_bytes;         // Size of the constant cache in bytes (0 = constant loads go to the L1 cache)
+	unsigned const_ways;          // Associativity of the constant cache
+	unsigned sector_size;         // Size of a sector in bytes (0 = whole cache-lines are transferred)
+	unsigned l2_sets;             // Number of sets in each bank of the L2 cache
+	unsigned tex_sets;            // Number of sets in the texture cache
+	unsigned const_sets;          // Number of sets in the constant cache
 };
 
+//////////////////////////////////
+// Data-structure linking a key of the configuration file to a hardware setting
+//////////////////////////////////
+#define NUM_SETTING_KEYS 23
+struct SettingKey {
+	const char* name;             // The key as used in the configuration files (e.g. "LINE_SIZE")
+	unsigned Settings::*field;    // The corresponding field of the settings
+};
+extern const SettingKey SETTING_KEYS[NUM_SETTING_KEYS];
+
+//////////////////////////////////
+// Data-structure collecting all model (run-time) options
+//////////////////////////////////
+class BufferMap;
+struct Options {
+	unsigned num_workers;         // Number of worker threads for the set-parallel mode (1 = serial)
+	double sample_rate;           // Fraction of cache-lines to sample (1.0 = exact model)
+	unsigned sample_threshold;    // Sampling threshold on the hash (sample_rate*SAMPLE_MODULUS)
+	bool verbose;                 // Whether or not to print progress information to stdout
+	std::string config_file;      // The configuration file with the hardware settings
+	std::vector<std::string> overrides; // Overrides of the hardware settings (as KEY=value)
+	unsigned num_jobs;            // Number of concurrent kernels or sweep jobs (0 = one per hardware thread)
+	bool use_cache;               // Whether or not to re-use results from the result cache
+	std::ostream* output;         // Stream to print progress information and results to (e.g. stdout)
+	unsigned memory_budget;       // Memory budget in MB (0 = half the physical memory)
+	bool spill;                   // Whether or not to spill the accesses of large kernels to a file
+	std::string latency_file;     // Histogram of memory latencies to draw from (empty = half-normal)
+	unsigned long seed;           // Seed for all randomness in the model (e.g. memory latencies)
+	unsigned num_seeds;           // Number of seeds to model (seed, seed+1, ...) to report the variance
+	bool json_output;             // Whether or not to write a summary of the results as JSON
+	std::string histogram_format; // Format to write the histograms of all cases in ("csv", "bin" or empty)
+	bool mrc_output;              // Whether or not to write the miss-ratio curves
+	unsigned bandwidth_window;    // Size of the time windows (in cycles) to measure the peak bandwidth demand
+	bool slot_output;             // Whether or not to profile and write the accesses and misses per instruction slot
+	std::string buffer_file;      // Address ranges of the buffers to attribute the accesses and misses to (empty = none)
+	std::shared_ptr<const BufferMap> buffer_map; // The buffers of 'buffer_file', read and validated once (null = none)
+};
+
+//////////////////////////////////
+// Spatial sampling of cache-lines (as in SHARDS): a line is sampled if its hash
+// falls below the threshold. All accesses to a sampled line are modelled.
+//////////////////////////////////
+inline bool is_sampled(unsigned long line_addr, const Options &options) {
+	if (options.sample_threshold >= SAMPLE_MODULUS) { return true; }
+	unsigned long hash = line_addr + 0x9E3779B97F4A7C15UL;
+	hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9UL;
+	hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBUL;
+	hash = hash ^ (hash >> 31);
+	return ((hash % SAMPLE_MODULUS) < options.sample_threshold);
+}
+
+//////////////////////////////////
+// Scale a reuse distance measured on the sampled lines to the full trace
+//////////////////////////////////
+inline unsigned scale_distance(unsigned distance, const Options &options) {
+	if (distance == INF || options.sample_rate >= 1.0) { return distance; }
+	return (unsigned)std::round(distance/options.sample_rate);
+}
+
 //////////////////////////////////
 // Data-structure to capture a memory request
 //////////////////////////////////
@@ -140,6 +279,65 @@ struct Request {
 	unsigned set;                 // Set number of the request
 };
 
+//////////////////////////////////
+// Cache geometry as a (sets,ways,mapping type,cache) tuple, used to look-up per-
+// set access counts
+//////////////////////////////////
+typedef std::tuple<unsigned,unsigned,unsigned,unsigned> Geometry;
+
+//////////////////////////////////
+// Function to select the cache serving an access: texture and constant loads go
+// to their own caches if these are modelled, all other accesses go to the L1
+//////////////////////////////////
+inline unsigned access_to_cache(unsigned direction, const Settings &hardware) {
+	if (direction == ACCESS_TEXTURE && hardware.tex_bytes > 0) { return CACHE_TEX; }
+	if (direction == ACCESS_CONSTANT && hardware.const_bytes > 0) { return CACHE_CONST; }
+	return CACHE_L1;
+}
+
+//////////////////////////////////
+// Data-structure describing a read-only cache next to the L1 cache (the texture
+// or the constant cache): its geometry, its accesses per set and its histogram
+//////////////////////////////////
+struct ReadOnlyCache {
+	unsigned id;                  // The cache identifier (CACHE_TEX or CACHE_CONST)
+	unsigned sets;                // Number of sets
+	unsigned ways;                // Number of ways
+	const std::vector<unsigned> *num_total_accesses; // Number of accesses per set
+	map_type<unsigned,unsigned> *distances; // The reuse distance histogram (output)
+};
+
+//////////////////////////////////
+// Data-structure to capture an L1 miss sent to the L2 cache, and the stream of
+// misses of a single core (in order of time)
+//////////////////////////////////
+struct MissEvent {
+	unsigned long line_addr;      // Cache-line address of the miss
+	unsigned time;                // Time at which the miss is sent to the L2 cache
+};
+typedef std::vector<MissEvent> MissStream;
+
+//////////////////////////////////
+// Data-structure to capture a scheduled access to a single set (set-parallel mode)
+//////////////////////////////////
+struct SetAccess {
+	unsigned long line_addr;      // Cache-line address of the access
+	unsigned point;               // Index of the process-point following the access
+	unsigned store_bytes;         // Number of bytes written by a store (0 for a load)
+	unsigned sectors;             // Mask of the sectors accessed by the warp (sectored mode only)
+};
+
+//////////////////////////////////
+// Data-structure holding a fixed warp schedule, partitioned per set. Requests
+// are processed at 'process-points': after each warp portion and at the end of
+// each time-step (see reuse_distance). Their timestamps are stored here.
+//////////////////////////////////
+struct Schedule {
+	std::vector<std::vector<SetAccess>> accesses; // Scheduled accesses per set
+	std::vector<unsigned> point_times;            // Timestamp of each process-point
+	std::vector<unsigned> snum_points;            // Final process-point of each set of active threads
+};
+
 //////////////////////////////////
 // Class holding information about a GPU thread
 //////////////////////////////////
@@ -150,25 +348,48 @@ class Thread {
 // Public variables and functions
 public:
 	unsigned pc;                  // The thread's 'program counter'
-	std::vector<Access> accesses; // List of memory accesses to perform
+	std::vector<Access> accesses; // List of memory accesses to perform (if not spilled)
+	Access* spilled;              // List of memory accesses in a spill-file (if spilled)
+	unsigned num_spilled;         // Number of memory accesses in the spill-file
+	std::shared_ptr<SpillFile> spill_file; // The spill-file (shared by the threads of a kernel)
 	
 	// Initialise the thread and set its program counter to zero
 	Thread() {
 		pc = 0;
 		warpid = INF;
 		blockid = INF;
+		spilled = 0;
+		num_spilled = 0;
+	}
+	
+	// Store the accesses in a spill-file from now on, starting at a given location
+	void set_spilled(std::shared_ptr<SpillFile> file, Access* start) {
+		spill_file = file;
+		spilled = start;
+		num_spilled = 0;
 	}
 	
 	// Add a new access to the list of accesses
 	void append_access(Access access) {
-		accesses.push_back(access);
+		if (spilled) { spilled[num_spilled++] = access; }
+		else { accesses.push_back(access); }
+	}
+	
+	// Get the number of accesses
+	unsigned get_num_accesses() const {
+		return (spilled) ? num_spilled : accesses.size();
+	}
+	
+	// Get a single access (from memory or from the spill-file)
+	Access& get_access(unsigned index) {
+		return (spilled) ? spilled[index] : accesses[index];
 	}
 	
 	// Take the next access and increment the program counter
 	Access schedule() {
 		pc++;
-		assert(pc-1 < accesses.size());
-		return accesses[pc-1];
+		assert(pc-1 < get_num_accesses());
+		return get_access(pc-1);
 	}
 	
 	// Put back the program counter: undo the previous schedule command
@@ -179,13 +400,13 @@ public:
 	
 	// Find out how many bytes the following access will have
 	unsigned get_bytes() {
-		if (pc == accesses.size()) { return 1; }
-		else { return accesses[pc].bytes; }
+		if (pc == get_num_accesses()) { return 1; }
+		else { return get_access(pc).bytes; }
 	}
 	
 	// Find out if this thread has no more accesses to make
 	bool is_done() {
-		return (pc == accesses.size());
+		return (pc == get_num_accesses());
 	}
 	
 	// Reset the program counter to zero
@@ -193,6 +414,13 @@ public:
 		pc = 0;
 	}
 	
+	// Remove all the stores from the list of accesses (if not spilled)
+	void remove_stores() {
+		accesses.erase(std::remove_if(accesses.begin(), accesses.end(), [](const Access &access) {
+			return access.direction == 1;
+		}), accesses.end());
+	}
+	
 	// Set the thread's warp identifier to a given value
 	void set_warp(unsigned _warpid) {
 		assert(warpid == INF);
@@ -207,30 +435,113 @@ public:
 };
 
 //////////////////////////////////
-// Class holding a pool of warps
+// Warp scheduling policies of the pool of warps. A policy selects the warp to
+// issue from the ready warps (in order of arrival in the pool), or none (INF), and
+// is told when a warp stalls (returns with a delay, on a miss or not) or retires.
+// The policy is a template parameter of the pool, such that the selection is
+// inlined in the model's loop.
+//////////////////////////////////
+
+// Loose round-robin (LRR): issue the warp which is ready for the longest time
+class PolicyLRR {
+public:
+	PolicyLRR(const Settings &hardware) { }
+	unsigned select(const std::vector<unsigned> &ready) { return 0; }
+	void stalled(unsigned warp, bool miss) { }
+	void retired(unsigned warp) { }
+};
+
+// Greedy-then-oldest (GTO): keep issuing the same warp until it stalls, then
+// issue the oldest ready warp (the lowest warp identifier)
+class PolicyGTO {
+	unsigned last;                         // The warp issued last
+public:
+	PolicyGTO(const Settings &hardware) {
+		last = INF;
+	}
+	unsigned select(const std::vector<unsigned> &ready) {
+		unsigned oldest = 0;
+		for (unsigned i=0; i<ready.size(); i++) {
+			if (ready[i] == last) { return i; }
+			if (ready[i] < ready[oldest]) { oldest = i; }
+		}
+		last = ready[oldest];
+		return oldest;
+	}
+	void stalled(unsigned warp, bool miss) { }
+	void retired(unsigned warp) { }
+};
+
+// Two-level: issue warps round-robin from a small active group only, such that
+// nothing is issued while none of the active warps is ready. A warp leaves the
+// group when it stalls on a long-latency access (a miss) or retires, after which
+// the ready warp which arrived first in the pool is promoted into the group.
+class PolicyTwoLevel {
+	std::vector<unsigned> group;           // The warps in the active group
+	unsigned group_size;                   // Maximum number of warps in the active group
+	
+	// Find out whether a warp is in the active group
+	bool is_active(unsigned warp) const {
+		return (std::find(group.begin(), group.end(), warp) != group.end());
+	}
+	
+	// Remove a warp from the active group (if it is in there)
+	void demote(unsigned warp) {
+		std::vector<unsigned>::iterator it = std::find(group.begin(), group.end(), warp);
+		if (it != group.end()) { group.erase(it); }
+	}
+public:
+	PolicyTwoLevel(const Settings &hardware) {
+		group_size = std::max(1u,hardware.scheduler_group_size);
+	}
+	unsigned select(const std::vector<unsigned> &ready) {
+		
+		// Fill the empty places in the group (left by demoted or retired warps)
+		for (unsigned i=0; i<ready.size() && group.size() < group_size; i++) {
+			if (!is_active(ready[i])) { group.push_back(ready[i]); }
+		}
+		
+		// Issue the active warp which is ready for the longest time
+		for (unsigned i=0; i<ready.size(); i++) {
+			if (is_active(ready[i])) { return i; }
+		}
+		return INF;
+	}
+	void stalled(unsigned warp, bool miss) { if (miss) { demote(warp); } }
+	void retired(unsigned warp) { demote(warp); }
+};
+
+//////////////////////////////////
+// Class holding a pool of warps, scheduled according to a policy (see above)
 //////////////////////////////////
+template <class Policy>
 class Pool {
 	std::vector<unsigned> warps;           // A list of warps in the pool
 	std::map<unsigned,unsigned> in_flight; // A list of in-flight warps
 	unsigned size;                         // Size of the warp pool
+	Policy policy;                         // The warp scheduling policy
+	unsigned selected;                     // The warp selected by the policy (index into the pool)
 
 // Public variables and functions
 public:
 	unsigned done;                         // Status implemented as a counter
 	
 	// Initialise the pool
-	Pool() {
+	Pool(const Settings &hardware) :
+		policy(hardware) {
 		done = 0;
 		size = 0;
+		selected = INF;
 	}
 	
-	// Add a warp to the in-flight pool
-	void add_warp(unsigned _warpid, unsigned future_time) {
+	// Add a warp to the in-flight pool (stalled on a miss or not)
+	void add_warp(unsigned _warpid, unsigned future_time, bool miss) {
 		if (future_time == 0) {
 			warps.push_back(_warpid);
 		}
 		else {
 			in_flight[_warpid] = future_time;
+			policy.stalled(_warpid,miss);
 		}
 	}
 	
@@ -249,21 +560,31 @@ public:
 		}
 	}
 	
-	// Take (and remove) a warp from the front (FIFO) of the pool
+	// Take (and remove) the warp selected by the policy (see has_work) from the pool
 	unsigned take_warp() {
-		unsigned warp = warps[0];
-		warps.erase(warps.begin());
+		assert(selected != INF);
+		unsigned warp = warps[selected];
+		warps.erase(warps.begin()+selected);
+		selected = INF;
 		return warp;
 	}
 	
+	// Mark a warp as done: it is not returned to the pool anymore
+	void retire_warp(unsigned _warpid) {
+		done++;
+		policy.retired(_warpid);
+	}
+	
 	// Set the size of the pool
 	void set_size() {
 		size = warps.size();
 	}
 	
-	// Find out if there is work in the pool at this time
+	// Find out if there is work in the pool at this time: a ready warp which the
+	// policy selects for issue
 	bool has_work() {
-		return (warps.size() > 0);
+		selected = (warps.size() > 0) ? policy.select(warps) : INF;
+		return (selected != INF);
 	}
 	
 	// Find out whether all warps in the pool are done working
@@ -274,25 +595,39 @@ public:
 };
 
 //////////////////////////////////
-// Class containing outstanding memory requests
+// Class containing outstanding memory requests (allocated from an arena)
 //////////////////////////////////
+typedef std::vector<Request,ArenaAllocator<Request>> request_vector;
 class Requests {
-	std::map<unsigned,std::vector<Request>> request_list; // A list of outstanding requests
-	std::set<unsigned> unique_requests;                   // List of unique outstanding requests
+	typedef std::map<unsigned,request_vector,std::less<unsigned>,
+	                 ArenaAllocator<std::pair<const unsigned,request_vector>>> request_map;
+	request_map request_list;                                             // A list of outstanding requests
+	std::set<unsigned,std::less<unsigned>,ArenaAllocator<unsigned>> unique_requests; // List of unique outstanding requests
 
 // Public variables and functions
 public:
 	
 	// Initialise the pool of outstanding requests
-	Requests() {
+	Requests(Arena &arena) :
+		request_list(std::less<unsigned>(),ArenaAllocator<Request>(arena)),
+		unique_requests(std::less<unsigned>(),ArenaAllocator<Request>(arena)) {
 	}
 	
 	// Add a new request to the lists
 	void add(unsigned long addr, unsigned future_time, unsigned set) {
-		request_list[future_time].push_back(Request({addr,set}));
+		request_map::iterator it = request_list.find(future_time);
+		if (it == request_list.end()) {
+			it = request_list.insert(std::make_pair(future_time,request_vector(request_list.get_allocator()))).first;
+		}
+		it->second.push_back(Request({addr,set}));
 		unique_requests.insert(addr);
 	}
 	
+	// Check whether a request for an address is outstanding already
+	bool is_outstanding(unsigned long addr) {
+		return (unique_requests.count(addr) > 0);
+	}
+	
 	// Return the number of unique outstanding requests
 	unsigned get_num_requests() {
 		return unique_requests.size();
@@ -300,21 +635,471 @@ public:
 	
 	// Check whether there are current outstanding requests
 	bool has_requests(unsigned current_time) {
-		return (request_list[current_time].size() > 0);
+		request_map::iterator it = request_list.find(current_time);
+		return (it != request_list.end() && it->second.size() > 0);
+	}
+	
+	// Find the earliest time with outstanding requests (INF if there are none)
+	unsigned get_next_time() {
+		request_map::iterator it = request_list.begin();
+		while (it != request_list.end() && it->second.size() == 0) {
+			request_list.erase(it++);
+		}
+		return (it == request_list.end()) ? INF : it->first;
 	}
 	
 	// Process the current outstanding requests
-	std::vector<Request> get_requests(unsigned current_time) {
-		std::vector<Request> current = request_list[current_time];
-		for (std::vector<Request>::iterator it = current.begin(); it != current.end(); it++) {
-			Request request = *it;
-			unique_requests.erase(request.addr);
+	request_vector get_requests(unsigned current_time) {
+		request_map::iterator it = request_list.find(current_time);
+		request_vector current(request_list.get_allocator());
+		if (it != request_list.end()) {
+			current.swap(it->second);
+			request_list.erase(it);
+		}
+		for (request_vector::iterator request = current.begin(); request != current.end(); request++) {
+			unique_requests.erase(request->addr);
 		}
-		request_list.erase(current_time);
 		return current;
 	}
 };
 
+//////////////////////////////////
+// Data-structure holding the stores and the write traffic (see WriteTracker)
+//////////////////////////////////
+struct WriteStats {
+	unsigned stores;              // Number of stores (after coalescing)
+	unsigned store_hits;          // Number of stores hitting in the cache
+	unsigned store_misses;        // Number of stores missing in the cache
+	unsigned write_evictions;     // Number of lines evicted to allocate a line for a store (write-allocate only)
+	unsigned write_backs;         // Number of dirty lines written back (write-back only, including those left at the end)
+	unsigned long write_bytes;    // Number of bytes written to the next level of the memory hierarchy
+};
+
+//////////////////////////////////
+// Class implementing the write policy of a cache: it decides whether a store
+// allocates a cache-line, and keeps track of the write traffic. With write-through
+// (no-allocate), every store is sent on and a store miss bypasses the cache. With
+// write-back (write-allocate), a store makes its line dirty. A dirty line is
+// written back when it is evicted, which shows up as a miss on its next access,
+// or at the end if it is still dirty.
+//////////////////////////////////
+class WriteTracker {
+	unsigned write_policy;        // The write policy (see the hardware settings)
+	double cache_ways;            // Number of ways (scaled when sampling)
+	unsigned line_size;           // The size of a cache-line (in bytes)
+	line_map_type dirty;          // The dirty state of the cache-lines (write-back only)
+	std::vector<unsigned> set_lines; // Number of distinct cache-lines accessed per set (write-back only)
+
+// Public variables and functions
+public:
+	WriteStats stats;             // The stores and the write traffic so far
+	
+	// Initialise the tracker for a number of sets
+	WriteTracker(unsigned num_sets, unsigned _cache_ways, const Settings &hardware, const Options &options, Arena &arena) :
+		write_policy(hardware.write_policy),
+		cache_ways(_cache_ways*options.sample_rate),
+		line_size(hardware.line_size),
+		dirty(0,line_map_type::hasher(),line_map_type::key_equal(),line_map_type::allocator_type(arena)),
+		set_lines((hardware.write_policy == 2) ? num_sets : 0, 0) {
+		stats = WriteStats({0,0,0,0,0,0});
+	}
+	
+	// Find out whether an access allocates or updates its line in the cache, given whether
+	// it misses and whether it is a store (without accounting for the access)
+	bool allocates(bool miss, bool is_store) const {
+		return !(is_store && miss && write_policy == 1);
+	}
+	
+	// Account for an access given whether its cache-line is accessed for the first time,
+	// whether it misses, and the number of bytes written (0 for a load). Returns whether
+	// the access allocates or updates the line in the cache.
+	bool access(unsigned long line_addr, unsigned set, bool first, bool miss, unsigned store_bytes) {
+		if (write_policy == 2) {
+			if (first) {
+				set_lines[set]++;
+			}
+			
+			// A dirty line which misses has been evicted (and written back) since its previous access
+			else if (miss) {
+				line_map_type::iterator it = dirty.find(line_addr);
+				if (it != dirty.end() && it->second) {
+					stats.write_backs++;
+					it->second = 0;
+				}
+			}
+		}
+		if (store_bytes == 0) {
+			return true;
+		}
+		stats.stores++;
+		if (miss) { stats.store_misses++; }
+		else {      stats.store_hits++; }
+		
+		// Write-through, no-allocate: the store is sent on, a miss does not allocate
+		if (write_policy == 1) {
+			stats.write_bytes += store_bytes;
+			return !miss;
+		}
+		
+		// Write-back, write-allocate: the line becomes dirty, a miss evicts a line if the set is full
+		if (miss && (!first || set_lines[set] > cache_ways)) {
+			stats.write_evictions++;
+		}
+		dirty[line_addr] = 1;
+		return true;
+	}
+	
+	// Write back the lines which are still dirty at the end and return the statistics
+	WriteStats finish() {
+		for (line_map_type::iterator it = dirty.begin(); it != dirty.end(); it++) {
+			if (it->second) { stats.write_backs++; }
+		}
+		if (write_policy == 2) {
+			stats.write_bytes = (unsigned long)stats.write_backs*line_size;
+		}
+		return stats;
+	}
+};
+
+//////////////////////////////////
+// Data-structure holding the sector traffic of a sectored cache (see SectorTracker)
+//////////////////////////////////
+struct SectorStats {
+	unsigned sector_misses;       // Number of accesses hitting a tag, but missing one or more of its sectors
+	unsigned long fetched_sectors; // Number of sectors fetched from the next level of the memory hierarchy
+	unsigned long fetched_bytes;  // Number of bytes fetched from the next level of the memory hierarchy
+};
+
+//////////////////////////////////
+// Class tracking the sectors present in each cache-line of a sectored cache. The
+// reuse distances (and thus the hits and misses) stay those of the tags, so the
+// trees keep one entry per cache-line and only a mask of the present sectors is
+// added per cache-line. A tag miss means that the line was evicted: it is then
+// allocated with only the accessed sectors. A tag hit fetches the accessed sectors
+// which are not present (a sector miss).
+//////////////////////////////////
+class SectorTracker {
+	unsigned sector_size;         // The size of a sector (in bytes)
+	line_map_type present;        // The mask of the present sectors of each cache-line
+
+// Public variables and functions
+public:
+	SectorStats stats;            // The sector misses and the sector traffic so far
+	
+	// Initialise the tracker
+	SectorTracker(const Settings &hardware, Arena &arena) :
+		sector_size(hardware.sector_size),
+		present(0,line_map_type::hasher(),line_map_type::key_equal(),line_map_type::allocator_type(arena)) {
+		stats = SectorStats({0,0,0});
+	}
+	
+	// Return the mask of the accessed sectors which have to be fetched, given whether the tag misses
+	unsigned missing(unsigned long line_addr, unsigned sectors, bool tag_miss) const {
+		if (tag_miss) {
+			return sectors;
+		}
+		line_map_type::const_iterator it = present.find(line_addr);
+		return (it == present.end()) ? sectors : sectors & ~(it->second);
+	}
+	
+	// Account for an access to a set of sectors of a cache-line and fetch the missing ones
+	// (a store writes its sectors without fetching them)
+	void access(unsigned long line_addr, unsigned sectors, bool tag_miss, bool store) {
+		unsigned fetch = (store) ? 0 : missing(line_addr, sectors, tag_miss);
+		if (!tag_miss && fetch != 0) {
+			stats.sector_misses++;
+		}
+		stats.fetched_sectors += std::bitset<32>(fetch).count();
+		unsigned &mask = present[line_addr];
+		mask = (tag_miss) ? sectors : mask | sectors;
+	}
+	
+	// Return the statistics
+	SectorStats finish() {
+		stats.fetched_bytes = stats.fetched_sectors*sector_size;
+		return stats;
+	}
+};
+
+//////////////////////////////////
+// Data-structure holding the bandwidth demand of the misses (see BandwidthMeter)
+//////////////////////////////////
+struct BandwidthStats {
+	unsigned long bytes;          // Number of bytes requested from the next level of the memory hierarchy
+	unsigned cycles;              // Number of modelled cycles (the final value of the fake time)
+	unsigned window;              // Size of the time windows (in cycles)
+	unsigned long peak_bytes;     // Largest number of bytes requested in a single window
+};
+
+//////////////////////////////////
+// Class measuring the bandwidth demand of the miss requests while modelling. The
+// bytes of each request are added to the time window in which it is issued, so
+// only a counter per window is kept instead of the requests themselves. Requests
+// may be added out of order (e.g. per set), and meters can be merged.
+//////////////////////////////////
+class BandwidthMeter {
+	unsigned window;              // Size of the time windows (in cycles)
+	unsigned cycles;              // Number of modelled cycles so far
+	std::vector<unsigned long> window_bytes; // Number of bytes requested in each window
+
+// Public variables and functions
+public:
+	
+	// Initialise the meter with a given window size
+	BandwidthMeter(unsigned _window) :
+		window(std::max(1u,_window)),
+		cycles(0) {
+	}
+	
+	// Account for a request of a number of bytes issued at a given time
+	void add(unsigned timestamp, unsigned long bytes) {
+		unsigned w = timestamp/window;
+		if (w >= window_bytes.size()) {
+			window_bytes.resize(w+1,0);
+		}
+		window_bytes[w] += bytes;
+	}
+	
+	// Extend the modelled time up to a given number of cycles
+	void set_cycles(unsigned _cycles) {
+		cycles = std::max(cycles,_cycles);
+	}
+	
+	// Add the requests and the time of another meter (with the same window size)
+	void merge(const BandwidthMeter &other) {
+		if (other.window_bytes.size() > window_bytes.size()) {
+			window_bytes.resize(other.window_bytes.size(),0);
+		}
+		for (unsigned w=0; w<other.window_bytes.size(); w++) {
+			window_bytes[w] += other.window_bytes[w];
+		}
+		set_cycles(other.cycles);
+	}
+	
+	// Return the statistics (scaled to the full trace when sampling)
+	BandwidthStats finish(double sample_rate) {
+		BandwidthStats stats = { 0, cycles, window, 0 };
+		for (unsigned w=0; w<window_bytes.size(); w++) {
+			stats.bytes += window_bytes[w];
+			stats.peak_bytes = std::max(stats.peak_bytes,window_bytes[w]);
+		}
+		stats.bytes = (unsigned long)std::round(stats.bytes/sample_rate);
+		stats.peak_bytes = (unsigned long)std::round(stats.peak_bytes/sample_rate);
+		return stats;
+	}
+};
+
+//////////////////////////////////
+// Data-structure holding the accesses and the misses of a single entry of a
+// profile (e.g. an instruction slot or a buffer)
+//////////////////////////////////
+struct ProfileStats {
+	unsigned index;               // Index of the entry (e.g. the slot or the buffer)
+	unsigned cache;               // The cache serving the accesses (e.g. CACHE_L1)
+	unsigned accesses;            // Number of (coalesced) accesses
+	unsigned misses;              // Number of misses
+};
+
+//////////////////////////////////
+// Class holding reuse distance histograms per index, e.g. per instruction slot
+// (the index of an access in the list of accesses of its thread, its program
+// counter) or per buffer. All non-zero entries are kept in a single sparse map,
+// keyed by the index, the cache and the distance, such that the memory use grows
+// with the number of distinct distances per index only.
+//////////////////////////////////
+class AccessProfile {
+	map_type<unsigned long,unsigned> entries; // Frequency of each (index,cache,distance) key
+
+// Public variables and functions
+public:
+	
+	// Compose and decompose the keys (the distance takes the lower 32 bits)
+	static unsigned long key(unsigned index, unsigned cache, unsigned distance) {
+		return ((unsigned long)index << 34) | ((unsigned long)cache << 32) | distance;
+	}
+	static unsigned get_index(unsigned long key) { return (unsigned)(key >> 34); }
+	static unsigned get_cache(unsigned long key) { return (unsigned)((key >> 32) & 3); }
+	static unsigned get_distance(unsigned long key) { return (unsigned)(key & 0xFFFFFFFFUL); }
+	
+	// Account for an access of an index with a given reuse distance
+	void add(unsigned index, unsigned cache, unsigned distance) {
+		entries[key(index,cache,distance)]++;
+	}
+	
+	// Set the frequency of a key (e.g. when reading a profile back)
+	void set(unsigned long key, unsigned frequency) {
+		entries[key] = frequency;
+	}
+	
+	// Scale the frequencies to the full trace when sampling
+	void scale(double sample_rate) {
+		for (map_type<unsigned long,unsigned>::iterator it=entries.begin(); it!= entries.end(); it++) {
+			it->second = (unsigned)std::round(it->second/sample_rate);
+		}
+	}
+	
+	// Return all entries, sorted by index, cache and distance
+	std::vector<std::pair<unsigned long,unsigned>> sorted() const {
+		std::vector<std::pair<unsigned long,unsigned>> result(entries.begin(), entries.end());
+		std::sort(result.begin(), result.end());
+		return result;
+	}
+	
+	// Return the number of entries
+	unsigned size() const {
+		return entries.size();
+	}
+};
+
+//////////////////////////////////
+// Data-structure holding a buffer: a named range of addresses (e.g. an allocation)
+//////////////////////////////////
+struct Buffer {
+	std::string name;             // Name of the buffer
+	unsigned long base;           // The byte address of the first byte
+	unsigned long bytes;          // Size of the buffer in bytes
+};
+
+//////////////////////////////////
+// Class mapping addresses to buffers. The ranges are sorted by address, such
+// that an address is found with a binary search. Addresses outside all buffers
+// map to the index 'size()'. The buffers may not overlap.
+//////////////////////////////////
+class BufferMap {
+	std::vector<Buffer> buffers;      // The buffers, in the order as given
+	std::vector<unsigned long> bases; // The base addresses, sorted
+	std::vector<unsigned long> ends;  // The end addresses (exclusive), in the order of the bases
+	std::vector<unsigned> indices;    // The indices of the buffers, in the order of the bases
+
+// Public variables and functions
+public:
+	
+	// Initialise the map with a list of buffers (throws a runtime error if they overlap)
+	BufferMap(const std::vector<Buffer> &_buffers) :
+		buffers(_buffers) {
+		std::vector<std::pair<unsigned long,unsigned>> order;
+		for (unsigned b=0; b<buffers.size(); b++) {
+			order.push_back(std::make_pair(buffers[b].base,b));
+		}
+		std::sort(order.begin(), order.end());
+		for (unsigned i=0; i<order.size(); i++) {
+			const Buffer &buffer = buffers[order[i].second];
+			if (i > 0 && buffer.base < ends.back()) {
+				throw std::runtime_error("buffer '"+buffer.name+"' overlaps with another buffer");
+			}
+			bases.push_back(buffer.base);
+			ends.push_back(buffer.base+buffer.bytes);
+			indices.push_back(order[i].second);
+		}
+	}
+	
+	// Find the index of the buffer holding an address
+	unsigned find(unsigned long address) const {
+		std::vector<unsigned long>::const_iterator it = std::upper_bound(bases.begin(), bases.end(), address);
+		if (it == bases.begin()) { return indices.size(); }
+		unsigned i = (it - bases.begin()) - 1;
+		return (address < ends[i]) ? indices[i] : indices.size();
+	}
+	
+	// Return the number of buffers
+	unsigned size() const {
+		return indices.size();
+	}
+	
+	// Return the buffers (in the order as given, such that 'find' indexes them)
+	const std::vector<Buffer>& get_buffers() const {
+		return buffers;
+	}
+};
+
+//////////////////////////////////
+// Data-structure holding the optional outputs of modelling a single core (see
+// reuse_distance). An output is only collected if its pointer is set.
+//////////////////////////////////
+struct ModelOutputs {
+	MissStream *l2_stream;        // The stream of misses sent to the L2 cache
+	WriteStats *writes;           // The stores and the write traffic
+	SectorStats *sectors;         // The sector misses and the sector traffic
+	BandwidthMeter *bandwidth;    // The bytes of the miss requests per time window
+	AccessProfile *slots;         // The histograms per instruction slot
+	const BufferMap *buffer_map;  // The buffers to attribute the accesses to (with 'buffers')
+	AccessProfile *buffers;       // The histograms per buffer
+	
+	// Initialise without any outputs
+	ModelOutputs() :
+		l2_stream(0), writes(0), sectors(0), bandwidth(0), slots(0), buffer_map(0), buffers(0) {
+	}
+};
+
+//////////////////////////////////
+// Data-structure holding a kernel: its threads and their (coalesced) accesses,
+// and the assignment of threads to warps, warps to blocks and blocks to cores
+//////////////////////////////////
+struct Kernel {
+	std::vector<Thread> threads;                           // The threads and their accesses
+	std::vector<std::vector<unsigned>> warps;              // The threads belonging to each warp
+	std::vector<std::vector<unsigned>> blocks;             // The warps belonging to each threadblock
+	std::vector<std::vector<unsigned>> cores;              // The threadblocks assigned to each core
+	unsigned blocksize;                                    // The number of threads per threadblock
+	std::map<Geometry,std::vector<unsigned>> set_accesses; // Per-set access counts for each cache geometry
+	double schedule_time;                                  // Time taken to schedule the threads (in seconds)
+};
+
+//////////////////////////////////
+// Data-structure collecting the modelled cache misses and their causes
+//////////////////////////////////
+struct Misses {
+	unsigned accesses;            // Total number of (coalesced) accesses
+	unsigned hits;                // Number of cache hits
+	unsigned total;               // Total number of cache misses
+	unsigned compulsory;          // Misses caused by first-time accesses
+	unsigned capacity;            // Misses caused by the limited cache capacity
+	unsigned associativity;       // Misses caused by the limited associativity
+	unsigned latency;             // Misses caused by memory latencies (hits on in-flight lines)
+	unsigned mshr;                // Misses caused by a limited number of MSHRs
+	unsigned total_associativity; // Total misses with full-associativity (case 1)
+	unsigned total_latency;       // Total misses without latencies (case 2)
+	unsigned total_mshr;          // Total misses with unlimited MSHRs (case 3)
+	float miss_rate;              // The miss rate (in percentages)
+	float error_bound;            // Estimated error bound on the miss rate when sampling (in percentages)
+	unsigned l2_accesses;         // Number of accesses to the L2 cache (L1 misses, excluding merged ones)
+	unsigned l2_hits;             // Number of L2 cache hits
+	unsigned l2_misses;           // Number of L2 cache misses (accesses to off-chip memory)
+	float l2_miss_rate;           // The L2 miss rate (in percentages)
+	unsigned tex_accesses;        // Number of accesses to the texture cache
+	unsigned tex_misses;          // Number of texture cache misses
+	float tex_miss_rate;          // The texture cache miss rate (in percentages)
+	unsigned const_accesses;      // Number of accesses to the constant cache
+	unsigned const_misses;        // Number of constant cache misses
+	float const_miss_rate;        // The constant cache miss rate (in percentages)
+};
+
+//////////////////////////////////
+// Data-structure collecting the time spent in the different parts of the model
+//////////////////////////////////
+struct Timings {
+	double schedule;              // Assignment of threads and coalescing (in seconds)
+	double cases[NUM_CASES];      // Reuse distance calculation for each case (in seconds)
+	double l2;                    // Miss streams of the other cores and the L2 cache (in seconds)
+	double total;                 // Total time to model the kernel (in seconds)
+};
+
+//////////////////////////////////
+// Data-structure holding the results of modelling a kernel
+//////////////////////////////////
+struct Result {
+	std::vector<map_type<unsigned,unsigned>> distances; // Reuse distance histograms for each case (and the L2 cache)
+	Misses misses;                                      // The cache misses and their causes
+	Timings timings;                                    // The time spent modelling
+	unsigned active_blocks;                             // Number of threadblocks active at a time
+	std::vector<float> miss_rates;                      // Miss rates for each seed (multi-seed mode only)
+	WriteStats writes;                                  // The stores and the write traffic (normal case only)
+	SectorStats sectors;                                // The sector misses and traffic (normal case, sectored mode only)
+	BandwidthStats bandwidth;                           // The bandwidth demand of the misses (normal case only)
+	AccessProfile slots;                                // The histograms per instruction slot (normal case, if profiled)
+	AccessProfile buffers;                              // The histograms per buffer (normal case, if attributed)
+};
+
 //////////////////////////////////
 // Forward declarations
 //////////////////////////////////
@@ -323,19 +1108,76 @@ void reuse_distance(std::vector<unsigned> &core,
                     std::vector<std::vector<unsigned>> &warps,
                     std::vector<Thread> &threads,
                     map_type<unsigned,unsigned> &distances,
+                    const std::vector<unsigned> &num_total_accesses,
                     unsigned active_blocks,
                     const Settings hardware,
                     unsigned cache_sets,
                     unsigned cache_ways,
-                    unsigned mem_latency,
+                    LatencyProvider latencies,
                     unsigned non_mem_latency,
                     unsigned num_mshr,
-                    std::mt19937 gen,
-                    std::normal_distribution<> distribution);
+                    const Options options,
+                    Arena &arena,
+                    ModelOutputs &outputs,
+                    const std::vector<ReadOnlyCache> &read_only_caches);
+void reuse_distance_parallel(std::vector<unsigned> &core,
+                             std::vector<std::vector<unsigned>> &blocks,
+                             std::vector<std::vector<unsigned>> &warps,
+                             std::vector<Thread> &threads,
+                             map_type<unsigned,unsigned> &distances,
+                             const std::vector<unsigned> &num_total_accesses,
+                             unsigned active_blocks,
+                             const Settings hardware,
+                             unsigned cache_sets,
+                             unsigned cache_ways,
+                             LatencyProvider latencies,
+                             unsigned non_mem_latency,
+                             const Options options,
+                             std::vector<Arena> &arenas,
+                             ModelOutputs &outputs);
+void schedule_accesses(std::vector<unsigned> &core,
+                       std::vector<std::vector<unsigned>> &blocks,
+                       std::vector<std::vector<unsigned>> &warps,
+                       std::vector<Thread> &threads,
+                       const std::vector<unsigned> &num_total_accesses,
+                       unsigned active_blocks,
+                       const Settings hardware,
+                       unsigned cache_sets,
+                       unsigned cache_ways,
+                       const Options options,
+                       Schedule &schedule);
+void reuse_distance_set(const Schedule &schedule,
+                        unsigned set,
+                        unsigned num_accesses,
+                        map_type<unsigned,unsigned> &distances,
+                        const Settings hardware,
+                        unsigned cache_ways,
+                        LatencyProvider latencies,
+                        unsigned non_mem_latency,
+                        const Options options,
+                        Arena &arena,
+                        ModelOutputs &outputs);
+void l2_reuse_distance(const std::vector<MissStream> &streams,
+                       map_type<unsigned,unsigned> &distances,
+                       const Settings hardware,
+                       const Options options,
+                       Arena &arena);
+void process_requests_before(Requests &requests_hit,
+                             Requests &requests_miss,
+                             unsigned end_time,
+                             line_map_type &P,
+                             std::vector<Tree> &B,
+                             std::vector<unsigned> &set_counters);
+void scale_histogram(map_type<unsigned,unsigned> &distances,
+                     double sample_rate);
+void scale_writes(WriteStats &writes,
+                  double sample_rate);
+void scale_sectors(SectorStats &sectors,
+                   double sample_rate);
 void process_requests(Requests &requests,
                       unsigned timestamp,
                       unsigned set,
-                      map_type<unsigned long,unsigned> &P,
+                      line_map_type &P,
                       std::vector<Tree> &B,
                       std::vector<unsigned> &set_counters);
 void schedule_threads(std::vector<Thread> &threads,
@@ -344,21 +1186,175 @@ void schedule_threads(std::vector<Thread> &threads,
                       std::vector<std::vector<unsigned>> &cores,
                       const Settings hardware,
                       unsigned block_size);
-void output_miss_rate(std::vector<map_type<unsigned,unsigned>> &distances,
+unsigned sector_mask(std::vector<Thread> &threads,
+                     const std::vector<unsigned> &warp,
+                     unsigned tnum,
+                     unsigned tnum_stop,
+                     const Settings hardware);
+std::vector<unsigned> count_set_accesses(std::vector<Thread> &threads,
+                                         const Settings hardware,
+                                         unsigned cache_sets,
+                                         unsigned cache_ways,
+                                         unsigned mapping_type,
+                                         unsigned cache,
+                                         const Options options);
+void output_miss_rate(Result &result,
                       const std::string kernelname,
                       const std::string benchname,
-                      const Settings hardware);
+                      const Settings hardware,
+                      const Options options);
+void output_json(const Result &result,
+                 const std::string kernelname,
+                 const std::string benchname,
+                 const Settings hardware,
+                 const Options options);
+void output_histograms(const Result &result,
+                       const std::string kernelname,
+                       const std::string benchname,
+                       const Options options);
+void output_mrc(const Result &result,
+                const std::string kernelname,
+                const std::string benchname,
+                const Settings hardware);
+void output_slots(const std::vector<ProfileStats> &statistics,
+                  const std::vector<std::string> &instructions,
+                  const Result &result,
+                  const std::string kernelname,
+                  const std::string benchname);
+std::vector<std::string> read_slot_instructions(const std::string filename,
+                                                bool keep_stores);
+void output_buffers(const std::vector<ProfileStats> &statistics,
+                    const std::vector<Buffer> &buffer_list,
+                    const Result &result,
+                    const std::string kernelname,
+                    const std::string benchname);
+unsigned long parse_address(const std::string text,
+                            const std::string filename);
+std::vector<Buffer> read_buffers(const std::string filename);
 Dim3 read_file(std::vector<Thread> &threads,
                const std::string kernelname,
-               const std::string benchname);
+               const std::string benchname,
+               const Options options,
+               bool keep_stores);
+Dim3 read_trace(std::vector<Thread> &threads,
+                const std::string filename,
+                const Options options,
+                bool keep_stores);
 void verify_miss_rate(const std::string kernelname,
-                      const std::string benchname);
+                      const std::string benchname,
+                      const Options options);
 unsigned line_addr_to_set(unsigned long line_addr,
                           unsigned long addr,
                           unsigned num_sets,
-                          unsigned cache_bytes);
-Settings get_settings(void);
+                          unsigned cache_bytes,
+                          unsigned mapping_type);
+std::vector<std::pair<unsigned,unsigned>> read_latency_histogram(const std::string filename);
+Settings default_settings(void);
+bool set_setting(Settings &hardware,
+                 const std::string key,
+                 unsigned value);
+std::string finalise_settings(Settings &hardware);
+Settings get_settings(const Options options);
+Options default_options(void);
+Options get_options(int argc, char** argv, int first);
+double mean(const std::vector<float> &values);
+double variance(const std::vector<float> &values);
 void message(std::string x);
+void message(std::ostream &out, std::string x);
+
+//////////////////////////////////
+// Library API (see src/model/api.cpp)
+//////////////////////////////////
+void prepare_kernel(Kernel &kernel,
+                    const Dim3 blockdim,
+                    const Settings hardware);
+Result run_model(Kernel &kernel,
+                 const Settings hardware,
+                 const Options options);
+Result run_model_seeds(Kernel &kernel,
+                       const Settings hardware,
+                       const Options options);
+Result model_accesses(const std::vector<Thread> &threads,
+                      const Dim3 blockdim,
+                      const Settings hardware,
+                      const Options options);
+Result model_trace(const std::string filename,
+                   const Settings hardware,
+                   const Options options);
+Misses compute_misses(std::vector<map_type<unsigned,unsigned>> &distances,
+                      const Settings hardware,
+                      const Options options);
+double average_bandwidth(const BandwidthStats &bandwidth);
+double peak_bandwidth(const BandwidthStats &bandwidth);
+unsigned long dram_bytes(const Result &result,
+                         const Settings hardware);
+void count_misses(const map_type<unsigned,unsigned> &histogram,
+                  unsigned cache_ways,
+                  unsigned &accesses,
+                  unsigned &misses);
+std::vector<float> miss_ratio_curve(const map_type<unsigned,unsigned> &histogram);
+std::vector<ProfileStats> profile_statistics(const AccessProfile &profile,
+                                             const Settings hardware);
+double elapsed(std::chrono::steady_clock::time_point start);
+
+//////////////////////////////////
+// Modelling the kernels of a benchmark (see src/model/kernels.cpp)
+//////////////////////////////////
+std::vector<std::string> find_kernels(const std::string benchname);
+size_t get_memory_budget(const Options options);
+size_t get_peak_memory(void);
+size_t estimate_trace_memory(const std::string filename);
+size_t estimate_kernel_memory(const std::string kernelname,
+                              const std::string benchname);
+void model_kernel(const std::string kernelname,
+                  const std::string benchname,
+                  const Settings hardware,
+                  const Options options);
+void model_benchmark(const std::vector<std::string> &kernelnames,
+                     const std::string benchname,
+                     const Settings hardware,
+                     const Options options);
+
+//////////////////////////////////
+// Result cache (see src/model/cache.cpp)
+//////////////////////////////////
+unsigned long fnv_hash(unsigned long hash,
+                       const char* data,
+                       size_t bytes);
+unsigned long hash_file(std::ifstream &input_file);
+std::string get_cache_key(const std::string kernelname,
+                          const std::string benchname,
+                          const Settings hardware,
+                          const Options options);
+std::string get_cache_filename(const std::string key);
+void write_cached_profile(std::ofstream &file,
+                          const std::string name,
+                          const AccessProfile &profile);
+bool read_cached_profile(std::ifstream &input_file,
+                         AccessProfile &profile);
+bool load_cached_result(const std::string key,
+                        const Settings hardware,
+                        const Options options,
+                        Result &result);
+void store_cached_result(const std::string key,
+                         const Settings hardware,
+                         const Result &result);
+
+//////////////////////////////////
+// Parameter sweeps (see src/model/sweep.cpp)
+//////////////////////////////////
+std::string sweep_key(const std::string kernelname,
+                      const Settings hardware,
+                      const Options options,
+                      unsigned long latency_hash);
+std::vector<Settings> read_grid(const std::string filename,
+                                const Settings hardware,
+                                std::vector<std::string> &axes);
+std::vector<std::string> read_sweep_results(const std::string filename);
+void run_sweep(const std::string benchname,
+               const std::string gridname,
+               const Settings hardware,
+               const Options options);
 
 //////////////////////////////////
 
@@ -0,0 +1,425 @@
+//////////////////////////////////
+//
+// == A reuse distance based GPU cache model
+// This file is part of a cache model for GPUs. The cache model is based on
+// reuse distance theory extended to work with GPUs. The cache model primarly
+// focusses on modelling NVIDIA's Fermi architecture.
+//
+// == More information on the GPU cache model
+// Article............A Detailed GPU Cache Model Based on Reuse Distance Theory
+// Authors............C. Nugteren et al.
+//
+// == Contents of this file
+// This particular file implements a set-parallel version of the reuse distance
+// calculation (see src/model/reusedistance.cpp). The trees (B), set counters and
+// request queues are all per-set, only P and the warp pool couple the sets. In
+// this mode, the warp schedule is fixed first (without feedback of latencies
+// into the warp pool), after which each set is processed by a worker thread
+// with its own shard of P. Latencies of hits and misses are still modelled per
+// set, but warps no longer wait for their misses and MSHRs are not modelled.
+// For a zero-latency configuration the results are identical to the serial
+// implementation.
+//
+// == File details
+// Filename...........src/model/parallel.cpp
+// Author.............Cedric Nugteren <www.cedricnugteren.nl>
+// Affiliation........Eindhoven University of Technology, The Netherlands
+// Last modified on...16-Oct-2026
+//
+//////////////////////////////////
+
+// Include the header file
+#include "model.h"
+
+//////////////////////////////////
+// Function to fix the warp schedule and to partition the resulting accesses per
+// set. Warps are taken from a pool with the same policy as in the serial model,
+// but are always returned immediately (as if all accesses are hits with zero
+// latency).
+//////////////////////////////////
+template <class Policy>
+void schedule_accesses_policy(std::vector<unsigned> &core,
+                              std::vector<std::vector<unsigned>> &blocks,
+                              std::vector<std::vector<unsigned>> &warps,
+                              std::vector<Thread> &threads,
+                              const std::vector<unsigned> &num_total_accesses,
+                              unsigned active_blocks,
+                              const Settings hardware,
+                              unsigned cache_sets,
+                              unsigned cache_ways,
+                              const Options options,
+                              Schedule &schedule) {
+
+	// Prepare the per-set lists of accesses
+	schedule.accesses.assign(cache_sets,std::vector<SetAccess>());
+	for (unsigned set=0; set<cache_sets; set++) {
+		schedule.accesses[set].reserve(num_total_accesses[set]);
+	}
+	
+	// Set the (fake) time to 0
+	unsigned timestamp = 0;
+	
+	// Iterate round-robin over all the sets of active threads
+	for (unsigned snum = 0; snum < ceil(core.size()/(float)(active_blocks)); snum++) {
+	
+		// Create the pool of warps and fill them with warps belonging to this set of active threads
+		Pool<Policy> pool(hardware);
+		for (unsigned bnum = snum*active_blocks; bnum < (snum+1)*active_blocks && bnum < core.size(); bnum++) {
+			unsigned bid = core[bnum];
+			for (unsigned wnum = 0; wnum < blocks[bid].size(); wnum++) {
+				pool.add_warp(blocks[bid][wnum],0,false);
+			}
+		}
+		pool.set_size();
+		
+		// Loop over the warps in the warp pool
+		while (!pool.is_done()) {
+			if (pool.has_work()) {
+			
+				// Select a warp from the pool
+				unsigned wnum = pool.take_warp();
+				unsigned threads_done = 0;
+				
+				// Iterate over all the threads in this warp (in portions, see reuse_distance)
+				unsigned bytes = threads[warps[wnum][0]].get_bytes();
+				unsigned portions = std::max(1u,bytes/4);
+				for (unsigned warp_portion = 0; warp_portion < portions; warp_portion++) {
+					unsigned tnum_start = warp_portion*(hardware.warp_size/portions);
+					unsigned tnum_stop = (warp_portion+1)*(hardware.warp_size/portions);
+					for (unsigned tnum = tnum_start; tnum < tnum_stop && tnum < warps[wnum].size(); tnum++) {
+						unsigned tid = warps[wnum][tnum];
+						if (threads[tid].is_done()) {
+							threads_done++;
+						}
+						else {
+						
+							// Store the access with the set it maps to (unless it is coalesced or not sampled)
+							Access access = threads[tid].schedule();
+							if (access.width != 0 && is_sampled(access.address/hardware.line_size,options)) {
+								unsigned long line_addr = access.address/hardware.line_size;
+								unsigned set = line_addr_to_set(line_addr,access.address,cache_sets,cache_sets*cache_ways*hardware.line_size,hardware.mapping_type);
+								unsigned store_bytes = (access.direction == 1) ? access.end_address-access.address+1 : 0;
+								unsigned sectors = (hardware.sector_size > 0) ? sector_mask(threads,warps[wnum],tnum,tnum_stop,hardware) : 0;
+								schedule.accesses[set].push_back(SetAccess({line_addr,(unsigned)schedule.point_times.size(),store_bytes,sectors}));
+							}
+						}
+					}
+					
+					// Requests are processed after each warp portion
+					schedule.point_times.push_back(timestamp);
+				}
+				
+				// Return the warp to the pool without a delay (unless it is done)
+				if (threads_done == warps[wnum].size()) {
+					pool.retire_warp(wnum);
+				}
+				else {
+					pool.add_warp(wnum,0,false);
+				}
+			}
+			
+			// Requests are also processed at the end of each time-step
+			schedule.point_times.push_back(timestamp);
+			pool.process_warps_in_flight();
+			timestamp++;
+		}
+		schedule.snum_points.push_back(schedule.point_times.size()-1);
+	}
+	
+	// Reset all the program counters of the threads
+	for (unsigned tid=0; tid<threads.size(); tid++) {
+		threads[tid].reset();
+	}
+}
+
+//////////////////////////////////
+// Function to fix the warp schedule (see above) with the warp scheduling policy
+// selected in the hardware settings
+//////////////////////////////////
+void schedule_accesses(std::vector<unsigned> &core,
+                       std::vector<std::vector<unsigned>> &blocks,
+                       std::vector<std::vector<unsigned>> &warps,
+                       std::vector<Thread> &threads,
+                       const std::vector<unsigned> &num_total_accesses,
+                       unsigned active_blocks,
+                       const Settings hardware,
+                       unsigned cache_sets,
+                       unsigned cache_ways,
+                       const Options options,
+                       Schedule &schedule) {
+	// Select the instance of the scheduler for the warp scheduling policy (once)
+	decltype(&schedule_accesses_policy<PolicyLRR>) scheduler;
+	switch (hardware.warp_scheduler) {
+		case 1:  scheduler = schedule_accesses_policy<PolicyGTO>; break;
+		case 2:  scheduler = schedule_accesses_policy<PolicyTwoLevel>; break;
+		default: scheduler = schedule_accesses_policy<PolicyLRR>; break;
+	}
+	scheduler(core, blocks, warps, threads, num_total_accesses, active_blocks, hardware,
+	          cache_sets, cache_ways, options, schedule);
+}
+
+//////////////////////////////////
+// Helper function to process all outstanding hit and miss requests of a single
+// set which arrive before a given time (in order of arrival, hits first)
+//////////////////////////////////
+void process_requests_before(Requests &requests_hit,
+                             Requests &requests_miss,
+                             unsigned end_time,
+                             line_map_type &P,
+                             std::vector<Tree> &B,
+                             std::vector<unsigned> &set_counters) {
+	while (true) {
+		unsigned time = std::min(requests_hit.get_next_time(),requests_miss.get_next_time());
+		if (time == INF || time >= end_time) {
+			break;
+		}
+		process_requests(requests_hit,time,0,P,B,set_counters);
+		process_requests(requests_miss,time,0,P,B,set_counters);
+	}
+}
+
+//////////////////////////////////
+// Function to calculate the reuse distances of a single set given the fixed
+// schedule. It replays the set's accesses and processes the requests at the
+// same process-points as the serial implementation would. Optionally, the misses
+// of this set are written to a stream for the L2 cache, and the write traffic, the
+// sector traffic and the bandwidth demand of this set are collected.
+//////////////////////////////////
+void reuse_distance_set(const Schedule &schedule,
+                        unsigned set,
+                        unsigned num_accesses,
+                        map_type<unsigned,unsigned> &distances,
+                        const Settings hardware,
+                        unsigned cache_ways,
+                        LatencyProvider latencies,
+                        unsigned non_mem_latency,
+                        const Options options,
+                        Arena &arena,
+                        ModelOutputs &outputs) {
+	const std::vector<SetAccess> &accesses = schedule.accesses[set];
+	
+	// Create the data-structures for this set only (B, P and the set-counter)
+	std::vector<Tree> B;
+	B.emplace_back(num_accesses+STACK_EXTRA_SIZE,arena);
+	line_map_type P(0,line_map_type::hasher(),line_map_type::key_equal(),line_map_type::allocator_type(arena));
+	std::vector<unsigned> set_counters(1,1);
+	Requests requests_miss(arena);
+	Requests requests_hit(arena);
+	WriteTracker tracker(1,cache_ways,hardware,options,arena);
+	SectorTracker sector_tracker(hardware,arena);
+	
+	// Iterate over all the accesses to this set in the scheduled order
+	unsigned snum = 0;
+	unsigned previous_point = INF;
+	for (unsigned a = 0; a < accesses.size(); a++) {
+		const SetAccess &access = accesses[a];
+		
+		// A set of active threads has finished: all its requests have been processed
+		while (access.point > schedule.snum_points[snum]) {
+			process_requests_before(requests_hit,requests_miss,INF,P,B,set_counters);
+			snum++;
+		}
+		
+		// Process the requests up to the previous process-point. Requests arriving
+		// at the current time are only processed if this is not the first portion
+		// scheduled at this time.
+		unsigned timestamp = schedule.point_times[access.point];
+		if (access.point != previous_point) {
+			bool first = (access.point == 0 || schedule.point_times[access.point-1] != timestamp);
+			process_requests_before(requests_hit,requests_miss,(first) ? timestamp : timestamp+1,P,B,set_counters);
+			previous_point = access.point;
+		}
+		
+		// Find the previous occurence and the reuse distance
+		unsigned distance = INF;
+		if (P[access.line_addr]) {
+			distance = scale_distance(B[0].count(P[access.line_addr]),options);
+		}
+		
+		// Apply the write policy: a store which does not allocate bypasses the cache
+		bool allocate = true;
+		if (hardware.write_policy != 0) {
+			allocate = tracker.access(access.line_addr,0,P[access.line_addr] == 0,distance >= cache_ways,access.store_bytes);
+		}
+		
+		// Find the sectors to fetch (sectored mode only)
+		unsigned missing_sectors = 0;
+		if (hardware.sector_size > 0) {
+			missing_sectors = (access.store_bytes > 0) ? 0 : sector_tracker.missing(access.line_addr,access.sectors,distance >= cache_ways);
+		}
+		
+		// Does not fit in the cache (or misses sectors): model the memory latency
+		if ((distance >= cache_ways || missing_sectors != 0) && allocate) {
+			unsigned memory_latency = latencies.draw();
+			if (!requests_miss.is_outstanding(access.line_addr)) {
+				if (outputs.l2_stream) { outputs.l2_stream->push_back(MissEvent({access.line_addr,timestamp})); }
+				if (outputs.bandwidth) { outputs.bandwidth->add(timestamp,(hardware.sector_size > 0) ? std::bitset<32>(missing_sectors).count()*hardware.sector_size : hardware.line_size); }
+			}
+			requests_miss.add(access.line_addr,timestamp+memory_latency,0);
+		}
+		
+		// ... does fit in the cache, assign a pipeline (hit) latency
+		else if (allocate) {
+			requests_hit.add(access.line_addr,timestamp+non_mem_latency,0);
+		}
+		
+		// Update the present sectors (sectored mode only)
+		if (hardware.sector_size > 0 && allocate) {
+			sector_tracker.access(access.line_addr,access.sectors,distance >= cache_ways,access.store_bytes > 0);
+		}
+		
+		// Store the reuse distance in a histogram
+		distances[distance]++;
+	}
+	
+	// Collect the write traffic and the sector traffic
+	if (outputs.writes) {
+		*outputs.writes = tracker.finish();
+	}
+	if (outputs.sectors) {
+		*outputs.sectors = sector_tracker.finish();
+	}
+}
+
+//////////////////////////////////
+// Function to calculate the reuse distance for a single GPU core in parallel
+// over the sets. Outputs a histogram in the same format as the serial version,
+// and the same optional outputs except for the histograms per slot and per buffer.
+//////////////////////////////////
+void reuse_distance_parallel(std::vector<unsigned> &core,
+                             std::vector<std::vector<unsigned>> &blocks,
+                             std::vector<std::vector<unsigned>> &warps,
+                             std::vector<Thread> &threads,
+                             map_type<unsigned,unsigned> &distances,
+                             const std::vector<unsigned> &num_total_accesses,
+                             unsigned active_blocks,
+                             const Settings hardware,
+                             unsigned cache_sets,
+                             unsigned cache_ways,
+                             LatencyProvider latencies,
+                             unsigned non_mem_latency,
+                             const Options options,
+                             std::vector<Arena> &arenas,
+                             ModelOutputs &outputs) {
+
+	// Fix the warp schedule and partition the accesses per set
+	Schedule schedule;
+	schedule_accesses(core, blocks, warps, threads, num_total_accesses, active_blocks, hardware,
+	                  cache_sets, cache_ways, options, schedule);
+	
+	// Give each set its own sequence of latencies (seeded from the shared provider)
+	std::vector<unsigned long> seeds(cache_sets);
+	for (unsigned set=0; set<cache_sets; set++) {
+		seeds[set] = latencies.next_random();
+	}
+	
+	// Process the sets with the most accesses first to balance the load
+	std::vector<std::pair<unsigned,unsigned>> order(cache_sets);
+	for (unsigned set=0; set<cache_sets; set++) {
+		order[set] = std::make_pair((unsigned)schedule.accesses[set].size(),set);
+	}
+	std::sort(order.rbegin(),order.rend());
+	
+	// Launch the worker threads, each taking sets from a shared counter. Each worker
+	// uses its own arena, which is reset after each set.
+	unsigned num_workers = std::min((unsigned)arenas.size(),cache_sets);
+	std::vector<map_type<unsigned,unsigned>> worker_distances(num_workers);
+	std::vector<MissStream> set_streams((outputs.l2_stream) ? cache_sets : 0);
+	std::vector<WriteStats> set_writes((outputs.writes) ? cache_sets : 0);
+	std::vector<SectorStats> set_sectors((outputs.sectors) ? cache_sets : 0);
+	std::vector<BandwidthMeter> set_bandwidth((outputs.bandwidth) ? cache_sets : 0, BandwidthMeter(options.bandwidth_window));
+	std::atomic<unsigned> next_set(0);
+	std::vector<std::thread> workers;
+	for (unsigned w=0; w<num_workers; w++) {
+		workers.push_back(std::thread([&,w]() {
+			for (unsigned i = next_set++; i < cache_sets; i = next_set++) {
+				unsigned set = order[i].second;
+				LatencyProvider set_latencies = latencies;
+				set_latencies.set_seed(seeds[set]);
+				ModelOutputs set_outputs;
+				if (outputs.l2_stream) { set_outputs.l2_stream = &set_streams[set]; }
+				if (outputs.writes) { set_outputs.writes = &set_writes[set]; }
+				if (outputs.sectors) { set_outputs.sectors = &set_sectors[set]; }
+				if (outputs.bandwidth) { set_outputs.bandwidth = &set_bandwidth[set]; }
+				reuse_distance_set(schedule, set, num_total_accesses[set], worker_distances[w], hardware, cache_ways,
+				                   set_latencies, non_mem_latency, options, arenas[w], set_outputs);
+				arenas[w].reset();
+			}
+		}));
+	}
+	for (unsigned w=0; w<num_workers; w++) {
+		workers[w].join();
+	}
+	
+	// Merge the per-worker histograms
+	for (unsigned w=0; w<num_workers; w++) {
+		for(map_type<unsigned,unsigned>::iterator it=worker_distances[w].begin(); it!= worker_distances[w].end(); it++) {
+			distances[it->first] += it->second;
+		}
+	}
+	
+	// Merge the per-set miss streams in order of time (ties in order of the sets)
+	if (outputs.l2_stream) {
+		for (unsigned set=0; set<cache_sets; set++) {
+			outputs.l2_stream->insert(outputs.l2_stream->end(), set_streams[set].begin(), set_streams[set].end());
+		}
+		std::stable_sort(outputs.l2_stream->begin(), outputs.l2_stream->end(), [](const MissEvent &a, const MissEvent &b) {
+			return a.time < b.time;
+		});
+	}
+	
+	// Sum the per-set write traffic
+	if (outputs.writes) {
+		*outputs.writes = WriteStats({0,0,0,0,0,0});
+		for (unsigned set=0; set<cache_sets; set++) {
+			outputs.writes->stores          += set_writes[set].stores;
+			outputs.writes->store_hits      += set_writes[set].store_hits;
+			outputs.writes->store_misses    += set_writes[set].store_misses;
+			outputs.writes->write_evictions += set_writes[set].write_evictions;
+			outputs.writes->write_backs     += set_writes[set].write_backs;
+			outputs.writes->write_bytes     += set_writes[set].write_bytes;
+		}
+	}
+	
+	// Merge the per-set bandwidth demand (the modelled time is that of the schedule)
+	if (outputs.bandwidth) {
+		for (unsigned set=0; set<cache_sets; set++) {
+			outputs.bandwidth->merge(set_bandwidth[set]);
+		}
+		if (schedule.point_times.size() > 0) {
+			outputs.bandwidth->set_cycles(schedule.point_times.back()+1);
+		}
+	}
+	
+	// Sum the per-set sector traffic
+	if (outputs.sectors) {
+		*outputs.sectors = SectorStats({0,0,0});
+		for (unsigned set=0; set<cache_sets; set++) {
+			outputs.sectors->sector_misses   += set_sectors[set].sector_misses;
+			outputs.sectors->fetched_sectors += set_sectors[set].fetched_sectors;
+			outputs.sectors->fetched_bytes   += set_sectors[set].fetched_bytes;
+		}
+	}
+	
+	// Sanity check to see if all accesses are made (the accesses are counted over all cores)
+	unsigned grand_total = 0;
+	for (unsigned set=0; set<cache_sets; set++) {
+		grand_total += num_total_accesses[set];
+	}
+	unsigned distances_total = 0;
+	for(map_type<unsigned,unsigned>::iterator it=distances.begin(); it!= distances.end(); it++) {
+		distances_total += it->second;
+	}
+	if (hardware.num_cores == 1 && grand_total != distances_total) {
+		*options.output << "Error: " << grand_total << " != " << distances_total << std::endl;
+	}
+	
+	// Scale the histogram (and the write and sector traffic) to the full trace when sampling
+	if (options.sample_rate < 1.0) {
+		scale_histogram(distances, options.sample_rate);
+		if (outputs.writes) { scale_writes(*outputs.writes, options.sample_rate); }
+		if (outputs.sectors) { scale_sectors(*outputs.sectors, options.sample_rate); }
+	}
+}
+
+//////////////////////////////////
@@ -31,7 +31,7 @@
 // Filename...........src/model/reusedistance.cpp
 // Author.............Cedric Nugteren <www.cedricnugteren.nl>
 // Affiliation........Eindhoven University of Technology, The Netherlands
-// Last modified on...05-Sep-2013
+// Last modified on...16-Oct-2026
 //
 //////////////////////////////////
 
@@ -39,56 +39,91 @@
 #include "model.h"
 
 //////////////////////////////////
-// Function to calculate the reuse distance for a single GPU core:
-// * input: a vector of vectors containing the threads and their accesses
-// * requires: the total amount of accesses to be able to construct the tree
-// * output: a histogram (implemented as an unordered map) of the reuse distan-
-//   ces (distance as key and frequency as value)
+// Data-structure holding the state of a read-only cache (the texture or the
+// constant cache) while modelling: as for the L1 cache, a tree per set (B), the
+// hash (P), the set-counters and the pools of outstanding requests
 //////////////////////////////////
-void reuse_distance(std::vector<unsigned> &core,
-                    std::vector<std::vector<unsigned>> &blocks,
-                    std::vector<std::vector<unsigned>> &warps,
-                    std::vector<Thread> &threads,
-                    map_type<unsigned,unsigned> &distances,
-                    unsigned active_blocks,
-                    const Settings hardware,
-                    unsigned cache_sets,
-                    unsigned cache_ways,
-                    unsigned mem_latency,
-                    unsigned non_mem_latency,
-                    unsigned num_mshr,
-                    std::mt19937 gen,
-                    std::normal_distribution<> distribution) {
+struct ReadOnlyState {
+	const ReadOnlyCache *cache;
+	std::vector<Tree> B;
+	line_map_type P;
+	std::vector<unsigned> set_counters;
+	std::vector<Requests> requests_miss;
+	std::vector<Requests> requests_hit;
 	
-	// Prepare the computation of the number of accesses per set
-	std::vector<unsigned> num_total_accesses(cache_sets);
-	for (unsigned set=0; set<cache_sets; set++) {
-		num_total_accesses[set] = 0;
+	// Create the trees and the hash from the arena (the requests are created per set of active threads)
+	ReadOnlyState(const ReadOnlyCache &read_only_cache, Arena &arena) :
+		cache(&read_only_cache),
+		P(0,line_map_type::hasher(),line_map_type::key_equal(),line_map_type::allocator_type(arena)),
+		set_counters(read_only_cache.sets,1) {
+		B.reserve(cache->sets);
+		for (unsigned set=0; set<cache->sets; set++) {
+			B.emplace_back((*cache->num_total_accesses)[set]+STACK_EXTRA_SIZE,arena);
+		}
 	}
-	
-	// Compute the number of accesses per set (after coalescing has been performed)
-	for (unsigned tid=0; tid<threads.size(); tid++) {
-		while(!threads[tid].is_done()) {
-			Access access = threads[tid].schedule();
-			
-			// Only consider accesses that haven't been disabled because of coalescing
-			if (access.width != 0) {
-				unsigned long line_addr = access.address/hardware.line_size;
-				unsigned set = line_addr_to_set(line_addr,access.address,cache_sets,cache_sets*cache_ways*hardware.line_size);
-				num_total_accesses[set]++;
-				
-				// Check if this access spans multiple cache-lines 
-				unsigned long line_addr2 = access.end_address/hardware.line_size;
-				if (line_addr != line_addr2) {
-					set = line_addr_to_set(line_addr2,access.end_address,cache_sets,cache_sets*cache_ways*hardware.line_size);
-					num_total_accesses[set]++;
-				}
-			}
+};
+
+//////////////////////////////////
+// Function to process the outstanding requests of the read-only caches (see
+// 'process_requests' for the L1 cache)
+//////////////////////////////////
+void process_read_only_requests(std::vector<ReadOnlyState> &read_only_states,
+                                unsigned timestamp) {
+	for (unsigned c=0; c<read_only_states.size(); c++) {
+		ReadOnlyState &state = read_only_states[c];
+		for (unsigned set = 0; set < state.cache->sets; set++) {
+			process_requests(state.requests_hit[set],timestamp,set,state.P,state.B,state.set_counters);
+			process_requests(state.requests_miss[set],timestamp,set,state.P,state.B,state.set_counters);
 		}
-		
-		// Reset the threads so that the PCs start at 0 again
-		threads[tid].reset();
 	}
+}
+
+//////////////////////////////////
+// Function to calculate the reuse distance for a single GPU core:
+// * input: a vector of vectors containing the threads and their accesses
+// * requires: the total amount of accesses per set to be able to construct the
+//   trees (pre-computed once per cache geometry, see count_set_accesses)
+// * options: when sampling, only accesses to sampled cache-lines are modelled
+//   and the distances and frequencies are scaled to the full trace
+// * arena: all data-structures (B, P and requests) are allocated from the arena,
+//   which can be reset by the caller afterwards
+// * output: a histogram (implemented as an unordered map) of the reuse distan-
+//   ces (distance as key and frequency as value)
+// * outputs: the optional outputs below are collected if set (see ModelOutputs)
+// * output: optionally, the stream of misses sent to the L2 cache (in order of
+//   time, misses to cache-lines which are already requested are merged)
+// * output: optionally, the stores and the write traffic (the write policy itself
+//   is applied whenever stores are modelled)
+// * output: optionally, the sector misses and the sector traffic (the sectors are
+//   tracked whenever the sectored mode is enabled)
+// * output: optionally, the bytes of the miss requests per time window (in cache-
+//   lines, or in sectors in sectored mode)
+// * output: optionally, the histograms per instruction slot (the program counter
+//   of the thread making the access) for the L1 and the read-only caches
+// * output: optionally, the histograms per buffer (the address range holding the
+//   first byte of the access, found in the buffer map)
+// * output: optionally, the histograms of the texture and constant caches. Their
+//   loads share the warps and the time with the L1 cache, but have their own B
+//   and P. They are read-only and have no MSHRs, their misses go to the L2 cache.
+//////////////////////////////////
+template <class Policy>
+void reuse_distance_policy(std::vector<unsigned> &core,
+                           std::vector<std::vector<unsigned>> &blocks,
+                           std::vector<std::vector<unsigned>> &warps,
+                           std::vector<Thread> &threads,
+                           map_type<unsigned,unsigned> &distances,
+                           const std::vector<unsigned> &num_total_accesses,
+                           unsigned active_blocks,
+                           const Settings hardware,
+                           unsigned cache_sets,
+                           unsigned cache_ways,
+                           LatencyProvider latencies,
+                           unsigned non_mem_latency,
+                           unsigned num_mshr,
+                           const Options options,
+                           Arena &arena,
+                           ModelOutputs &outputs,
+                           const std::vector<ReadOnlyCache> &read_only_caches) {
 	
 	// Compute the grand total of accesses over all sets
 	unsigned grand_total = 0;
@@ -100,11 +135,28 @@ void reuse_distance(std::vector<unsigned> &core,
 	std::vector<Tree> B;
 	B.reserve(cache_sets);
 	for (unsigned set=0; set<cache_sets; set++) {
-		B.emplace_back(num_total_accesses[set]+STACK_EXTRA_SIZE);
+		B.emplace_back(num_total_accesses[set]+STACK_EXTRA_SIZE,arena);
 	}
 	
 	// Create the hash data structure (P in the Almasi et al. paper)
-	map_type<unsigned long,unsigned> P;
+	line_map_type P(0,line_map_type::hasher(),line_map_type::key_equal(),line_map_type::allocator_type(arena));
+	
+	// Create the write policy (only used if stores are modelled) and the sector tracker
+	// (only used in sectored mode)
+	WriteTracker tracker(cache_sets,cache_ways,hardware,options,arena);
+	SectorTracker sector_tracker(hardware,arena);
+	
+	// Create the state of the texture and constant caches (if their loads are modelled)
+	std::vector<ReadOnlyState> read_only_states;
+	read_only_states.reserve(read_only_caches.size());
+	ReadOnlyState* read_only_state[3] = { 0, 0, 0 };
+	for (unsigned c=0; c<read_only_caches.size(); c++) {
+		read_only_states.emplace_back(read_only_caches[c],arena);
+		read_only_state[read_only_caches[c].id] = &read_only_states.back();
+	}
+	
+	// Scale the number of MSHRs to the sampled cache-lines (keeping at least one)
+	const double mshr_limit = std::max(1.0,num_mshr*options.sample_rate);
 	
 	// Set the (fake) time to 0
 	unsigned timestamp = 0;
@@ -119,18 +171,22 @@ void reuse_distance(std::vector<unsigned> &core,
 	for (unsigned snum = 0; snum < ceil(core.size()/(float)(active_blocks)); snum++) {
 		
 		// Create the pool of warps and fill them with warps belonging to this set of active threads
-		Pool pool = Pool();
+		Pool<Policy> pool(hardware);
 		for (unsigned bnum = snum*active_blocks; bnum < (snum+1)*active_blocks && bnum < core.size(); bnum++) {
 			unsigned bid = core[bnum];
 			for (unsigned wnum = 0; wnum < blocks[bid].size(); wnum++) {
-				pool.add_warp(blocks[bid][wnum],0);
+				pool.add_warp(blocks[bid][wnum],0,false);
 			}
 		}
 		pool.set_size();
 		
 		// Create a pool of memory (misses) and non-memory (hits) requests
-		std::vector<Requests> requests_miss(cache_sets);
-		std::vector<Requests> requests_hit(cache_sets);
+		std::vector<Requests> requests_miss(cache_sets,Requests(arena));
+		std::vector<Requests> requests_hit(cache_sets,Requests(arena));
+		for (unsigned c=0; c<read_only_states.size(); c++) {
+			read_only_states[c].requests_miss.assign(read_only_states[c].cache->sets,Requests(arena));
+			read_only_states[c].requests_hit.assign(read_only_states[c].cache->sets,Requests(arena));
+		}
 		
 		// Loop over the warps in the warp pool
 		while (!pool.is_done()) {
@@ -147,6 +203,7 @@ void reuse_distance(std::vector<unsigned> &core,
 				// Select a warp from the pool
 				unsigned wnum = pool.take_warp();
 				unsigned max_future_time = 0;
+				bool missed = false;
 				unsigned threads_done = 0;
 				
 				// Iterate over all the threads in this warp
@@ -167,12 +224,45 @@ void reuse_distance(std::vector<unsigned> &core,
 						else {
 							
 							// Only schedule if the access is not performed by another thread (coalescing)
+							// and if the cache-line is sampled (approximate mode only)
 							Access access = threads[tid].schedule();
-							if (access.width != 0) {
+							if (access.width != 0 && is_sampled(access.address/hardware.line_size,options)) {
+								
+								// Texture and constant loads go to their own cache (if modelled)
+								unsigned cache = (read_only_states.empty()) ? CACHE_L1 : access_to_cache(access.direction,hardware);
+								if (cache != CACHE_L1) {
+									ReadOnlyState &state = *read_only_state[cache];
+									unsigned long line_addr = access.address/hardware.line_size;
+									unsigned set = line_addr_to_set(line_addr,access.address,state.cache->sets,state.cache->sets*state.cache->ways*hardware.line_size,0);
+									unsigned distance = INF;
+									if (state.P[line_addr]) {
+										distance = scale_distance(state.B[set].count(state.P[line_addr]),options);
+									}
+									
+									// A miss goes to the L2 cache, a hit gets the pipeline latency. The MSHRs (and their
+									// limit) belong to the L1 cache: a read-only miss neither takes nor waits for one.
+									if (distance >= state.cache->ways) {
+										unsigned memory_latency = latencies.draw();
+										max_future_time = std::max(max_future_time,memory_latency);
+										missed = true;
+										if (!state.requests_miss[set].is_outstanding(line_addr)) {
+											if (outputs.l2_stream) { outputs.l2_stream->push_back(MissEvent({line_addr,timestamp})); }
+											if (outputs.bandwidth) { outputs.bandwidth->add(timestamp,hardware.line_size); }
+										}
+										state.requests_miss[set].add(line_addr,timestamp+memory_latency,set);
+									}
+									else {
+										state.requests_hit[set].add(line_addr,timestamp+non_mem_latency,set);
+									}
+									(*state.cache->distances)[distance]++;
+									if (outputs.slots) { outputs.slots->add(threads[tid].pc-1,cache,distance); }
+									if (outputs.buffers) { outputs.buffers->add(outputs.buffer_map->find(access.address),cache,distance); }
+									continue;
+								}
 							
 								// Compute the line address and the set
 								unsigned long line_addr = access.address/hardware.line_size;
-								unsigned set = line_addr_to_set(line_addr,access.address,cache_sets,cache_sets*cache_ways*hardware.line_size);
+								unsigned set = line_addr_to_set(line_addr,access.address,cache_sets,cache_sets*cache_ways*hardware.line_size,hardware.mapping_type);
 								assert(set < cache_sets);
 								
 								// Find the previous occurence
@@ -185,50 +275,84 @@ void reuse_distance(std::vector<unsigned> &core,
 								// Find the reuse distance
 								unsigned distance = INF;
 								if (previous_time != INF) {
-									distance = B[set].count(previous_time);
+									distance = scale_distance(B[set].count(previous_time),options);
+								}
+								
+								// Apply the write policy: a store which does not allocate bypasses the cache (the
+								// tracker is only updated once the access is not undone by a lack of MSHRs)
+								bool allocate = true;
+								if (hardware.write_policy != 0) {
+									allocate = tracker.allocates(distance >= cache_ways,access.direction == 1);
 								}
 								
-								// Does not fit in the cache, mark as in-flight
+								// Find the sectors accessed by the warp and those to fetch (sectored mode only)
+								unsigned sectors = 0;
+								unsigned missing_sectors = 0;
+								if (hardware.sector_size > 0) {
+									sectors = sector_mask(threads,warps[wnum],tnum,tnum_stop,hardware);
+									missing_sectors = (access.direction == 1) ? 0 : sector_tracker.missing(line_addr,sectors,distance >= cache_ways);
+								}
+								
+								// Does not fit in the cache (or misses sectors), mark as in-flight
 								unsigned arrival_time;
-								if (distance >= cache_ways) {
+								if ((distance >= cache_ways || missing_sectors != 0) && allocate) {
 								
-									// Compute the memory latency based on a half-normal distribution
-									unsigned memory_latency = mem_latency + std::abs(std::round(distribution(gen)));
+									// Draw the memory latency (e.g. from a half-normal distribution)
+									unsigned memory_latency = latencies.draw();
 									arrival_time = timestamp + memory_latency;
 									
 									// Set this warp to return somewhere in the future
 									if (memory_latency > max_future_time) {
 										max_future_time = memory_latency;
 									}
+									missed = true;
 									
-									// Check if there are no more free MSHRs for this request
-									if (num_miss_requests >= num_mshr) {
+									// Check if there are no more free MSHRs for this request (scaled when sampling)
+									if (num_miss_requests >= mshr_limit) {
 										
 										// Undo the changes made for this thread/warp and break
 										if (tnum == 0) {
 											threads[tid].unschedule();
 											max_future_time = 0;
+											missed = false;
 											break; // (breaks out of the loop over a warp)
 										}
 									}
 									
+									// Send the miss to the L2 cache and measure its bytes (unless the cache-line is requested already)
+									if (!requests_miss[set].is_outstanding(line_addr)) {
+										if (outputs.l2_stream) { outputs.l2_stream->push_back(MissEvent({line_addr,timestamp})); }
+										if (outputs.bandwidth) { outputs.bandwidth->add(timestamp,(hardware.sector_size > 0) ? std::bitset<32>(missing_sectors).count()*hardware.sector_size : hardware.line_size); }
+									}
+									
 									// Add the current request to the miss-request pool (with a delay)
 									requests_miss[set].add(line_addr,arrival_time,set);
 								}
 								
 								// ... does fit in the cache, assign a pipeline (hit) latency
-								else {
+								else if (allocate) {
 									arrival_time = timestamp + non_mem_latency;
 									
 									// Add the current request to the hit-request pool (with a delay)
 									requests_hit[set].add(line_addr,arrival_time,set);
 								}
 								
+								// Update the write traffic (if stores are modelled) and the present sectors (sectored mode only)
+								if (hardware.write_policy != 0) {
+									unsigned store_bytes = (access.direction == 1) ? access.end_address-access.address+1 : 0;
+									tracker.access(line_addr,set,previous_time == INF,distance >= cache_ways,store_bytes);
+								}
+								if (hardware.sector_size > 0 && allocate) {
+									sector_tracker.access(line_addr,sectors,distance >= cache_ways,access.direction == 1);
+								}
+								
 								// Store the reuse distance in a histogram
 								if (!(distances[distance])) {
 									distances[distance] = 0;
 								}
 								distances[distance]++;
+								if (outputs.slots) { outputs.slots->add(threads[tid].pc-1,CACHE_L1,distance); }
+								if (outputs.buffers) { outputs.buffers->add(outputs.buffer_map->find(access.address),CACHE_L1,distance); }
 							}
 						}
 					}
@@ -238,16 +362,17 @@ void reuse_distance(std::vector<unsigned> &core,
 						process_requests(requests_hit[set],timestamp,set,P,B,set_counters);
 						process_requests(requests_miss[set],timestamp,set,P,B,set_counters);
 					}
+					process_read_only_requests(read_only_states,timestamp);
 				}
 				
 				// This warp is don: don't return it to the pool anymore
 				if (threads_done == warps[wnum].size()) {
-					pool.done++;
+					pool.retire_warp(wnum);
 				}
 				
-				// Return the warp to the pool with a delay
+				// Return the warp to the pool with a delay (stalled on a long-latency miss or not)
 				else {
-					pool.add_warp(wnum,max_future_time);
+					pool.add_warp(wnum,max_future_time,missed);
 				}
 			}
 			
@@ -256,6 +381,7 @@ void reuse_distance(std::vector<unsigned> &core,
 				process_requests(requests_hit[set],timestamp,set,P,B,set_counters);
 				process_requests(requests_miss[set],timestamp,set,P,B,set_counters);
 			}
+			process_read_only_requests(read_only_states,timestamp);
 			
 			// Process in-flight warps
 			pool.process_warps_in_flight();
@@ -269,17 +395,106 @@ void reuse_distance(std::vector<unsigned> &core,
 	for (unsigned tid=0; tid<threads.size(); tid++) {
 		threads[tid].reset();
 	}
+	if (outputs.bandwidth) {
+		outputs.bandwidth->set_cycles(timestamp);
+	}
 	
-	// Sanity check to see if all accesses are made
+	// Sanity check to see if all accesses are made (the accesses are counted over all cores)
 	unsigned distances_total = 0;
 	for(map_type<unsigned,unsigned>::iterator it=distances.begin(); it!= distances.end(); it++) {
 		distances_total += it->second;
 	}
-	if (grand_total != distances_total) {
-		std::cout << "Error: " << grand_total << " != " << distances_total << std::endl;
+	if (hardware.num_cores == 1 && grand_total != distances_total) {
+		*options.output << "Error: " << grand_total << " != " << distances_total << std::endl;
+	}
+	
+	// Collect the write traffic and the sector traffic
+	if (outputs.writes) {
+		*outputs.writes = tracker.finish();
+	}
+	if (outputs.sectors) {
+		*outputs.sectors = sector_tracker.finish();
+	}
+	
+	// Scale the histograms (and the write and sector traffic) to the full trace when sampling
+	if (options.sample_rate < 1.0) {
+		scale_histogram(distances, options.sample_rate);
+		for (unsigned c=0; c<read_only_caches.size(); c++) {
+			scale_histogram(*read_only_caches[c].distances, options.sample_rate);
+		}
+		if (outputs.writes) { scale_writes(*outputs.writes, options.sample_rate); }
+		if (outputs.sectors) { scale_sectors(*outputs.sectors, options.sample_rate); }
+		if (outputs.slots) { outputs.slots->scale(options.sample_rate); }
+		if (outputs.buffers) { outputs.buffers->scale(options.sample_rate); }
 	}
 }
 
+//////////////////////////////////
+// Function to calculate the reuse distance for a single GPU core (see above)
+// with the warp scheduling policy selected in the hardware settings
+//////////////////////////////////
+void reuse_distance(std::vector<unsigned> &core,
+                    std::vector<std::vector<unsigned>> &blocks,
+                    std::vector<std::vector<unsigned>> &warps,
+                    std::vector<Thread> &threads,
+                    map_type<unsigned,unsigned> &distances,
+                    const std::vector<unsigned> &num_total_accesses,
+                    unsigned active_blocks,
+                    const Settings hardware,
+                    unsigned cache_sets,
+                    unsigned cache_ways,
+                    LatencyProvider latencies,
+                    unsigned non_mem_latency,
+                    unsigned num_mshr,
+                    const Options options,
+                    Arena &arena,
+                    ModelOutputs &outputs,
+                    const std::vector<ReadOnlyCache> &read_only_caches) {
+	// Select the instance of the model for the warp scheduling policy (once)
+	decltype(&reuse_distance_policy<PolicyLRR>) model;
+	switch (hardware.warp_scheduler) {
+		case 1:  model = reuse_distance_policy<PolicyGTO>; break;
+		case 2:  model = reuse_distance_policy<PolicyTwoLevel>; break;
+		default: model = reuse_distance_policy<PolicyLRR>; break;
+	}
+	model(core, blocks, warps, threads, distances, num_total_accesses, active_blocks, hardware,
+	      cache_sets, cache_ways, latencies, non_mem_latency, num_mshr, options, arena, outputs, read_only_caches);
+}
+
+//////////////////////////////////
+// Function to scale the frequencies of a histogram measured on sampled cache-
+// lines: each sampled access represents 1/sample_rate accesses
+//////////////////////////////////
+void scale_histogram(map_type<unsigned,unsigned> &distances,
+                     double sample_rate) {
+	for(map_type<unsigned,unsigned>::iterator it=distances.begin(); it!= distances.end(); it++) {
+		it->second = (unsigned)std::round(it->second/sample_rate);
+	}
+}
+
+
+//////////////////////////////////
+// Function to scale the write traffic measured on sampled cache-lines (as above)
+//////////////////////////////////
+void scale_writes(WriteStats &writes,
+                  double sample_rate) {
+	writes.stores          = (unsigned)std::round(writes.stores/sample_rate);
+	writes.store_hits      = (unsigned)std::round(writes.store_hits/sample_rate);
+	writes.store_misses    = (unsigned)std::round(writes.store_misses/sample_rate);
+	writes.write_evictions = (unsigned)std::round(writes.write_evictions/sample_rate);
+	writes.write_backs     = (unsigned)std::round(writes.write_backs/sample_rate);
+	writes.write_bytes     = (unsigned long)std::round(writes.write_bytes/sample_rate);
+}
+
+//////////////////////////////////
+// Function to scale the sector traffic measured on sampled cache-lines (as above)
+//////////////////////////////////
+void scale_sectors(SectorStats &sectors,
+                   double sample_rate) {
+	sectors.sector_misses   = (unsigned)std::round(sectors.sector_misses/sample_rate);
+	sectors.fetched_sectors = (unsigned long)std::round(sectors.fetched_sectors/sample_rate);
+	sectors.fetched_bytes   = (unsigned long)std::round(sectors.fetched_bytes/sample_rate);
+}
 
 //////////////////////////////////
 // Function to process outstanding requests (actual modification of B and P)
@@ -287,13 +502,13 @@ void reuse_distance(std::vector<unsigned> &core,
 void process_requests(Requests &requests,
                       unsigned timestamp,
                       unsigned set,
-                      map_type<unsigned long,unsigned> &P,
+                      line_map_type &P,
                       std::vector<Tree> &B,
                       std::vector<unsigned> &set_counters) {
 	if (requests.has_requests(timestamp)) {
 		
 		// Get all requests for the current time and handle them in-order
-		std::vector<Request> current_requests = requests.get_requests(timestamp);
+		request_vector current_requests = requests.get_requests(timestamp);
 		for (unsigned r = 0; r < current_requests.size(); r++) {
 			Request request = current_requests[r];
 			
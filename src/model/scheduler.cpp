@@ -13,6 +13,7 @@
 // This particular file is implements 1) the mapping of threads to warps, thread-
 // blocks and GPU cores, and 2) memory coalescing. The implementation of coalesc-
 // ing is based on section "G.4.2. Global Memory" of the CUDA programming guide.
+// It also counts the (coalesced) accesses per set for a given cache geometry.
 //
 // == File details
 // Filename...........src/model/scheduler.cpp
@@ -65,26 +66,26 @@ void schedule_threads(std::vector<Thread> &threads,
 				unsigned tid = warps[wnum][tnum];
 				
 				// This thread has work to do
-				if (access < threads[tid].accesses.size()) {
+				if (access < threads[tid].get_num_accesses()) {
 					
 					// Compute the max schedule length (full-warps/half-warps/quarter-warps - see programming guide section "G.4.2. Global Memory")
 					unsigned schedule_length;
-					if      (threads[tid].accesses[access].bytes == 8)  { schedule_length = hardware.warp_size/2; }
-					else if (threads[tid].accesses[access].bytes == 16) { schedule_length = hardware.warp_size/4; }
+					if      (threads[tid].get_access(access).bytes == 8)  { schedule_length = hardware.warp_size/2; }
+					else if (threads[tid].get_access(access).bytes == 16) { schedule_length = hardware.warp_size/4; }
 					else                                                { schedule_length = hardware.warp_size; }
 					
 					// See if the same cache-block has already been loaded for other threads in this warp
-					unsigned long this_line = threads[tid].accesses[access].address/hardware.line_size;
+					unsigned long this_line = threads[tid].get_access(access).address/hardware.line_size;
 					for (unsigned old_tnum=schedule_length*(tnum/schedule_length); old_tnum<tnum; old_tnum++) {
 						unsigned old_tid = warps[wnum][old_tnum];
-						unsigned long old_line = threads[old_tid].accesses[access].address/hardware.line_size;
+						unsigned long old_line = threads[old_tid].get_access(access).address/hardware.line_size;
 						
-						// The cache-block has been loaded earlier, coalescing the accesses
-						if (this_line == old_line) {
-							threads[tid].accesses[access].width = 0;
-							if (threads[tid].accesses[access].address != threads[old_tid].accesses[access].address) {
-								threads[old_tid].accesses[access].end_address = std::max(threads[old_tid].accesses[access].end_address, threads[tid].accesses[access].end_address);
-								threads[old_tid].accesses[access].width++;
+						// The cache-block has been loaded earlier, coalescing the accesses (loads and stores separately)
+						if (this_line == old_line && threads[tid].get_access(access).direction == threads[old_tid].get_access(access).direction) {
+							threads[tid].get_access(access).width = 0;
+							if (threads[tid].get_access(access).address != threads[old_tid].get_access(access).address) {
+								threads[old_tid].get_access(access).end_address = std::max(threads[old_tid].get_access(access).end_address, threads[tid].get_access(access).end_address);
+								threads[old_tid].get_access(access).width++;
 							}
 							break;
 						}
@@ -92,7 +93,7 @@ void schedule_threads(std::vector<Thread> &threads,
 				}
 				
 				// This thread is done
-				else if (access == threads[tid].accesses.size()) {
+				else if (access == threads[tid].get_num_accesses()) {
 					done++;
 				}
 			}
@@ -101,3 +102,81 @@ void schedule_threads(std::vector<Thread> &threads,
 }
 
 //////////////////////////////////
+
+//////////////////////////////////
+// Function to compute the mask of the sectors of a cache-line accessed by a warp
+// in sectored mode. The access of thread 'tnum' (just scheduled) is the coalesced
+// access of the cache-line: the threads coalesced into it follow it within the
+// same warp portion. The original sizes of the accesses are used, as coalescing
+// only keeps the extent of the accesses (which can cover unaccessed sectors).
+//////////////////////////////////
+unsigned sector_mask(std::vector<Thread> &threads,
+                     const std::vector<unsigned> &warp,
+                     unsigned tnum,
+                     unsigned tnum_stop,
+                     const Settings hardware) {
+	unsigned index = threads[warp[tnum]].pc-1;
+	const Access &first = threads[warp[tnum]].get_access(index);
+	unsigned long line_addr = first.address/hardware.line_size;
+	unsigned long line_start = line_addr*hardware.line_size;
+	unsigned mask = 0;
+	for (unsigned t = tnum; t < tnum_stop && t < warp.size(); t++) {
+		Thread &thread = threads[warp[t]];
+		if (index < thread.get_num_accesses()) {
+			const Access &access = thread.get_access(index);
+			if ((t == tnum || access.width == 0) && access.direction == first.direction && access.address/hardware.line_size == line_addr) {
+				
+				// Set the bits of the sectors covered by this access (up to the end of the cache-line)
+				unsigned long end_address = std::min(access.address+access.bytes-1, line_start+hardware.line_size-1);
+				unsigned first_sector = (access.address-line_start)/hardware.sector_size;
+				unsigned last_sector = (end_address-line_start)/hardware.sector_size;
+				for (unsigned sector = first_sector; sector <= last_sector; sector++) {
+					mask |= 1u << sector;
+				}
+			}
+		}
+	}
+	return mask;
+}
+
+//////////////////////////////////
+// Function to count the number of accesses per set (after coalescing has been
+// performed). The result only depends on the set mapping and on the coalescing,
+// so it is computed once per cache geometry and shared by all cases using it.
+// Only the accesses served by the given cache (see access_to_cache) are counted.
+// When sampling, only the accesses to sampled cache-lines are counted.
+//////////////////////////////////
+std::vector<unsigned> count_set_accesses(std::vector<Thread> &threads,
+                                         const Settings hardware,
+                                         unsigned cache_sets,
+                                         unsigned cache_ways,
+                                         unsigned mapping_type,
+                                         unsigned cache,
+                                         const Options options) {
+	std::vector<unsigned> num_total_accesses(cache_sets,0);
+	unsigned cache_bytes = cache_sets*cache_ways*hardware.line_size;
+	for (unsigned tid=0; tid<threads.size(); tid++) {
+		for (unsigned a=0; a<threads[tid].get_num_accesses(); a++) {
+			const Access &access = threads[tid].get_access(a);
+			
+			// Only consider accesses to this cache that haven't been disabled because of coalescing
+			if (access.width != 0 && access_to_cache(access.direction,hardware) == cache) {
+				unsigned long line_addr = access.address/hardware.line_size;
+				if (is_sampled(line_addr,options)) {
+					unsigned set = line_addr_to_set(line_addr,access.address,cache_sets,cache_bytes,mapping_type);
+					num_total_accesses[set]++;
+				}
+				
+				// Check if this access spans multiple cache-lines
+				unsigned long line_addr2 = access.end_address/hardware.line_size;
+				if (line_addr != line_addr2 && is_sampled(line_addr2,options)) {
+					unsigned set = line_addr_to_set(line_addr2,access.end_address,cache_sets,cache_bytes,mapping_type);
+					num_total_accesses[set]++;
+				}
+			}
+		}
+	}
+	return num_total_accesses;
+}
+
+//////////////////////////////////
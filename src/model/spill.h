@@ -0,0 +1,100 @@
+//////////////////////////////////
+//
+// == A reuse distance based GPU cache model
+// This file is part of a cache model for GPUs. The cache model is based on
+// reuse distance theory extended to work with GPUs. The cache model primarly
+// focusses on modelling NVIDIA's Fermi architecture.
+//
+// == More information on the GPU cache model
+// Article............A Detailed GPU Cache Model Based on Reuse Distance Theory
+// Authors............C. Nugteren et al.
+//
+// == Contents of this file
+// This particular file implements a spill-file: a temporary file which is
+// memory-mapped to hold data which does not fit in the memory budget (e.g. the
+// accesses of a very large trace). The operating system loads the data from the
+// file on demand and can write it back and drop it under memory pressure. The
+// file is removed as soon as it is created, so it never outlives the process.
+// The model spills all the (not yet coalesced) accesses of a kernel at once, see
+// read_trace.
+//
+// == File details
+// Filename...........src/model/spill.h
+// Author.............Cedric Nugteren <www.cedricnugteren.nl>
+// Affiliation........Eindhoven University of Technology, The Netherlands
+// Last modified on...16-Oct-2026
+//
+//////////////////////////////////
+
+#ifndef SPILL_H
+#define SPILL_H
+
+// C++ headers
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <algorithm>
+
+// System headers (for the memory-mapped file)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <stdlib.h>
+
+//////////////////////////////////
+// The memory-mapped spill-file
+//////////////////////////////////
+class SpillFile {
+	void* data;                   // Start of the memory-mapped file
+	size_t bytes;                 // Size of the file (in bytes)
+	
+	// Disable copying: the spill-file owns its mapping
+	SpillFile(const SpillFile&);
+	SpillFile& operator=(const SpillFile&);
+
+public:
+
+	// Create a spill-file of a given size in a given folder and map it into memory
+	SpillFile(const std::string folder, size_t _bytes) {
+		bytes = std::max(_bytes,(size_t)1);
+		mkdir(folder.c_str(), 0755);
+		std::string name = folder+"/spill_XXXXXX";
+		std::vector<char> filename(name.begin(), name.end());
+		filename.push_back('\0');
+		int file = mkstemp(filename.data());
+		if (file < 0) {
+			throw std::runtime_error("could not create a spill-file in '"+folder+"'");
+		}
+		unlink(filename.data());
+		if (ftruncate(file, bytes) != 0) {
+			close(file);
+			throw std::runtime_error("could not allocate a spill-file of the requested size");
+		}
+		data = mmap(0, bytes, PROT_READ|PROT_WRITE, MAP_SHARED, file, 0);
+		close(file);
+		if (data == MAP_FAILED) {
+			throw std::runtime_error("could not memory-map the spill-file");
+		}
+	}
+	
+	// Unmap (and thereby delete) the spill-file
+	~SpillFile() {
+		munmap(data, bytes);
+	}
+	
+	// Get the start of the memory-mapped data
+	void* get_data() {
+		return data;
+	}
+	
+	// Tell the operating system that the data will not be used for a while: the
+	// pages are written back to the file and their memory is released
+	void release() {
+		msync(data, bytes, MS_ASYNC);
+		madvise(data, bytes, MADV_DONTNEED);
+	}
+};
+
+//////////////////////////////////
+
+#endif
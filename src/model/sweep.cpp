@@ -0,0 +1,320 @@
+//////////////////////////////////
+//
+// == A reuse distance based GPU cache model
+// This file is part of a cache model for GPUs. The cache model is based on
+// reuse distance theory extended to work with GPUs. The cache model primarly
+// focusses on modelling NVIDIA's Fermi architecture.
+//
+// == More information on the GPU cache model
+// Article............A Detailed GPU Cache Model Based on Reuse Distance Theory
+// Authors............C. Nugteren et al.
+//
+// == Contents of this file
+// This particular file implements parameter sweeps: a benchmark is modelled for
+// all points of a grid of hardware settings. Each kernel's trace is read only
+// once, and is scheduled and coalesced once for every combination of the line
+// size, warp size and number of cores in the grid. The configurations are then
+// modelled concurrently by a work-stealing pool of workers (see src/model/jobs.h).
+// Results are appended to a single table (CSV), one row per kernel and config-
+// uration. Rows already present in the table are skipped, such that an inter-
+// rupted sweep can be resumed by running it again.
+//
+// == File details
+// Filename...........src/model/sweep.cpp
+// Author.............Cedric Nugteren <www.cedricnugteren.nl>
+// Affiliation........Eindhoven University of Technology, The Netherlands
+// Last modified on...16-Oct-2026
+//
+//////////////////////////////////
+
+// Include the header file
+#include "model.h"
+
+// Global settings for the directory structure (see src/model/io.cpp)
+extern std::string output_dir;
+
+//////////////////////////////////
+// Function to create the key of a row in the results table: the kernel name, all
+// the hardware settings and the options which change the results (as printed in
+// the table). The latency histogram is identified by the hash of its contents (0
+// if the latencies are drawn from a half-normal distribution).
+//////////////////////////////////
+std::string sweep_key(const std::string kernelname,
+                      const Settings hardware,
+                      const Options options,
+                      unsigned long latency_hash) {
+	std::ostringstream key;
+	key << kernelname;
+	for (unsigned k=0; k<NUM_SETTING_KEYS; k++) {
+		key << "," << hardware.*(SETTING_KEYS[k].field);
+	}
+	key << "," << options.sample_rate << "," << options.seed << "," << (options.num_workers > 1)
+	    << "," << std::hex << latency_hash << std::dec << "," << options.bandwidth_window;
+	return key.str();
+}
+
+//////////////////////////////////
+// Function to read a grid of hardware settings from a file. Each line contains a
+// key (as in the configuration files) followed by the values to sweep over, e.g.
+// 'CACHE_WAYS 2 4 8'. Lines starting with '#' are comments. The grid is the cross-
+// product of all values, settings which are not in the grid keep their value.
+// Points with an invalid combination of settings are skipped.
+//////////////////////////////////
+std::vector<Settings> read_grid(const std::string filename,
+                                const Settings hardware,
+                                std::vector<std::string> &axes) {
+	std::vector<std::vector<unsigned>> values;
+	
+	// Test if the file exists
+	std::ifstream input_file(filename);
+	if (!input_file) {
+		std::cout << "### Error: could not read grid file '" << filename << "'" << std::endl;
+		message("");
+		exit(1);
+	}
+	
+	// Parse the keys and their values
+	std::string line;
+	while (std::getline(input_file, line)) {
+		std::istringstream line_stream(line);
+		std::string key;
+		if (!(line_stream >> key) || key[0] == '#') { continue; }
+		Settings test = hardware;
+		std::vector<unsigned> key_values;
+		unsigned value;
+		while (line_stream >> value) {
+			key_values.push_back(value);
+		}
+		if (key_values.size() == 0 || !line_stream.eof() || !set_setting(test, key, 0)) {
+			std::cout << "### Error: invalid grid line '" << line << "' in '" << filename << "'" << std::endl;
+			message("");
+			exit(1);
+		}
+		axes.push_back(key);
+		values.push_back(key_values);
+	}
+	
+	// Iterate over all points of the grid (the last key changes fastest)
+	std::vector<Settings> points;
+	std::vector<unsigned> index(axes.size(),0);
+	unsigned num_invalid = 0;
+	while (true) {
+		Settings point = hardware;
+		for (unsigned a=0; a<axes.size(); a++) {
+			set_setting(point, axes[a], values[a][index[a]]);
+		}
+		if (finalise_settings(point) == "") { points.push_back(point); }
+		else { num_invalid++; }
+		
+		// Move to the next point
+		int a = axes.size()-1;
+		while (a >= 0 && ++index[a] == values[a].size()) {
+			index[a] = 0;
+			a--;
+		}
+		if (a < 0) { break; }
+	}
+	if (num_invalid > 0) {
+		std::cout << "### Skipping " << num_invalid << " invalid point(s) of the grid" << std::endl;
+	}
+	return points;
+}
+
+//////////////////////////////////
+// Function to read the rows of an existing results table (without the header).
+// Incomplete rows (e.g. of an interrupted sweep) are ignored.
+//////////////////////////////////
+std::vector<std::string> read_sweep_results(const std::string filename) {
+	std::vector<std::string> rows;
+	std::ifstream input_file(filename);
+	std::string line;
+	while (std::getline(input_file, line)) {
+		if (std::count(line.begin(), line.end(), ',') == SWEEP_NUM_COLUMNS-1 && line.compare(0,7,"kernel,") != 0) {
+			rows.push_back(line);
+		}
+	}
+	return rows;
+}
+
+//////////////////////////////////
+// Function to run a parameter sweep over a grid of hardware settings for all the
+// kernels of a benchmark
+//////////////////////////////////
+void run_sweep(const std::string benchname,
+               const std::string gridname,
+               const Settings hardware,
+               const Options options) {
+	std::string filename = output_dir+"/"+benchname+"/"+benchname+"_sweep.csv";
+	
+	// Read the grid, the results of an earlier (possibly interrupted) sweep and the hash
+	// of the latency histogram (part of the keys)
+	std::vector<std::string> axes;
+	std::vector<Settings> points = read_grid(gridname, hardware, axes);
+	std::vector<std::string> rows = read_sweep_results(filename);
+	unsigned long latency_hash = 0;
+	if (options.latency_file != "") {
+		std::ifstream latency_file(options.latency_file, std::ios::binary);
+		latency_hash = hash_file(latency_file);
+	}
+	std::set<std::string> done;
+	for (unsigned r=0; r<rows.size(); r++) {
+		size_t end = 0;
+		for (unsigned c=0; c<SWEEP_KEY_COLUMNS; c++) {
+			end = rows[r].find(',', end+1);
+		}
+		done.insert(rows[r].substr(0,end));
+	}
+	unsigned num_workers = options.num_jobs;
+	if (num_workers == 0) { num_workers = std::max(1u,std::thread::hardware_concurrency()); }
+	std::cout << "### Sweeping over " << points.size() << " configuration(s) with " << num_workers << " worker(s)" << std::endl;
+	if (done.size() > 0) {
+		std::cout << "### Resuming: found " << done.size() << " result(s) in '" << filename << "'" << std::endl;
+	}
+	
+	// Re-write the results table with only the complete rows
+	std::ofstream file(filename);
+	if (!file) {
+		std::cout << "### Error: could not write results file '" << filename << "'" << std::endl;
+		message("");
+		exit(1);
+	}
+	file << "kernel";
+	for (unsigned k=0; k<NUM_SETTING_KEYS; k++) {
+		file << "," << SETTING_KEYS[k].name;
+	}
+	file << ",sample_rate,seed,parallel,latency_histogram,bandwidth_window,accesses,hits,misses,compulsory,capacity,associativity,latency,mshr,miss_rate,error_bound,time" << std::endl;
+	for (unsigned r=0; r<rows.size(); r++) {
+		file << rows[r] << std::endl;
+	}
+	
+	// The workers model quietly. The accesses are not spilled, as each variant
+	// modifies (coalesces) its own copy of them. The slots and buffers are not
+	// profiled, as only the totals are reported.
+	Options run_options = options;
+	run_options.verbose = false;
+	run_options.spill = false;
+	run_options.slot_output = false;
+	run_options.buffer_file = "";
+	run_options.buffer_map.reset();
+	
+	// Find all the traces in the folder (one trace per kernel)
+	std::vector<std::string> kernelnames = find_kernels(benchname);
+	if (kernelnames.size() == 0) {
+		std::cout << "### Error: could not read file '" << output_dir << "/" << benchname << "/" << benchname << "_00.trc'" << std::endl;
+		message("");
+		exit(1);
+	}
+	
+	// Loop over all the kernels
+	for (unsigned kernel_id = 0; kernel_id < kernelnames.size(); kernel_id++) {
+		std::string kernelname = kernelnames[kernel_id];
+		
+		// Find the configurations which still have to be modelled for this kernel
+		std::vector<unsigned> todo;
+		for (unsigned p=0; p<points.size(); p++) {
+			if (done.find(sweep_key(kernelname, points[p], options, latency_hash)) == done.end()) {
+				todo.push_back(p);
+			}
+		}
+		
+		// Load the memory access trace (once for all configurations, with the stores if
+		// any of the configurations models them)
+		bool keep_stores = false;
+		for (unsigned t=0; t<todo.size(); t++) {
+			keep_stores = keep_stores || (points[todo[t]].write_policy != 0);
+		}
+		std::vector<Thread> threads(MAX_THREADS);
+		Dim3 blockdim = read_trace(threads, output_dir+"/"+benchname+"/"+kernelname+".trc", run_options, keep_stores);
+		if (blockdim.x*blockdim.y*blockdim.z == 0) {
+			std::cout << "### Error: '" << output_dir << "/" << benchname << "/" << kernelname << ".trc' is not a valid memory access trace" << std::endl;
+			continue;
+		}
+		message("");
+		std::cout << "### Kernel '" << kernelname << "': " << todo.size() << " configuration(s) to model" << std::endl;
+		if (todo.size() == 0) { continue; }
+		
+		// Schedule and coalesce the threads once for each line size, warp size, number
+		// of cores and whether stores are modelled (the only settings the schedule
+		// depends on)
+		std::map<std::tuple<unsigned,unsigned,unsigned,bool>,unsigned> variant_ids;
+		std::vector<std::pair<unsigned,unsigned>> jobs;
+		for (unsigned t=0; t<todo.size(); t++) {
+			const Settings &point = points[todo[t]];
+			std::tuple<unsigned,unsigned,unsigned,bool> variant = std::make_tuple(point.line_size, point.warp_size, point.num_cores, point.write_policy != 0);
+			if (variant_ids.find(variant) == variant_ids.end()) {
+				unsigned id = variant_ids.size();
+				variant_ids[variant] = id;
+			}
+			jobs.push_back(std::make_pair(variant_ids[variant],todo[t]));
+		}
+		std::vector<Kernel> variants(variant_ids.size());
+		for (unsigned j=0; j<jobs.size(); j++) {
+			Kernel &kernel = variants[jobs[j].first];
+			if (kernel.threads.size() == 0) {
+				kernel.threads = threads;
+				if (keep_stores && points[jobs[j].second].write_policy == 0) {
+					for (unsigned tid=0; tid<kernel.threads.size(); tid++) {
+						kernel.threads[tid].remove_stores();
+					}
+				}
+				prepare_kernel(kernel, blockdim, points[jobs[j].second]);
+			}
+		}
+		threads.clear();
+		threads.shrink_to_fit();
+		
+		// Order the jobs by variant, such that each worker mostly models a single variant
+		std::stable_sort(jobs.begin(), jobs.end());
+		
+		// Model the configurations concurrently. The model modifies the state of the
+		// threads while running, so each worker models on its own copy of a variant.
+		std::vector<Kernel> local(num_workers);
+		std::vector<unsigned> local_variant(num_workers,INF);
+		std::mutex output_lock;
+		unsigned num_done = 0;
+		JobPool pool(num_workers);
+		pool.run(jobs.size(), [&](unsigned w, unsigned j) {
+			unsigned variant = jobs[j].first;
+			const Settings &point = points[jobs[j].second];
+			if (local_variant[w] != variant) {
+				local[w] = variants[variant];
+				local_variant[w] = variant;
+			}
+			std::ostringstream row;
+			std::string error;
+			float miss_rate = 0;
+			try {
+				Result result = run_model(local[w], point, run_options);
+				const Misses &misses = result.misses;
+				row << sweep_key(kernelname, point, options, latency_hash) << "," << misses.accesses << "," << misses.hits << "," << misses.total << ","
+				    << misses.compulsory << "," << misses.capacity << "," << misses.associativity << "," << misses.latency << ","
+				    << misses.mshr << "," << misses.miss_rate << "," << misses.error_bound << "," << result.timings.total;
+				miss_rate = misses.miss_rate;
+			}
+			catch (std::exception &e) {
+				error = e.what();
+			}
+			
+			// Store the results (flushed immediately to be able to resume) and report on the progress
+			std::lock_guard<std::mutex> guard(output_lock);
+			num_done++;
+			std::cout << "### [" << num_done << "/" << jobs.size() << "]";
+			for (unsigned a=0; a<axes.size(); a++) {
+				for (unsigned k=0; k<NUM_SETTING_KEYS; k++) {
+					if (axes[a] == SETTING_KEYS[k].name) { std::cout << " " << axes[a] << "=" << point.*(SETTING_KEYS[k].field); }
+				}
+			}
+			if (error == "") {
+				file << row.str() << std::endl;
+				std::cout << " => miss rate: " << miss_rate << "%" << std::endl;
+			}
+			else {
+				std::cout << " => error: " << error << std::endl;
+			}
+		});
+	}
+	message("");
+	std::cout << "### Results written to '" << filename << "'" << std::endl;
+}
+
+//////////////////////////////////
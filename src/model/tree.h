@@ -15,7 +15,8 @@
 // as presented in literature (see below - section 4.4). The tree structure is a
 // partial sum-hierarchy tree. It is chosen for its complexity of implementation
 // versus performance trade-off. Other trees could perform better, but change
-// over time, requiring additional implementation effort.
+// over time, requiring additional implementation effort. The nodes are allocated
+// from an arena (see src/model/arena.h) and are released together with it.
 //
 // == More information on reuse distance implementation
 // Article............Calculating stack distances efficiently
@@ -33,6 +34,9 @@
 #ifndef TREE_H
 #define TREE_H
 
+// Custom includes
+#include "arena.h"
+
 //////////////////////////////////
 // Floor and ceiling functions
 //////////////////////////////////
@@ -65,34 +69,22 @@ class Tree {
 public:
 	Node* root;
 	
-	// Initialize the tree and fill it with a given size
-	Tree(unsigned _size) {
-		root = fill_tree(0,_size,0);
-	}
-	
-	// Delete the tree
-	~Tree() {
-		clean_tree(root);
+	// Initialize the tree and fill it with a given size (nodes are owned by the arena)
+	Tree(unsigned _size, Arena &arena) {
+		root = fill_tree(0,_size,0,arena);
 	}
 
 	// Method to recursively fill the tree with nodes
-	Node* fill_tree(unsigned start, unsigned size, unsigned level) {
-		Node* node = new Node(start+size-1,0);
+	Node* fill_tree(unsigned start, unsigned size, unsigned level, Arena &arena) {
+		Node* node = new (arena.allocate(sizeof(Node))) Node(start+size-1,0);
 		if (size > 1) {
 			unsigned val_left = CEIL_DIV(size,2);
 			unsigned val_right = FLOOR_DIV(size,2);
-			node->left = fill_tree(start,         val_left, level+1);
-			node->right = fill_tree(start+val_left,val_right,level+1);
+			node->left = fill_tree(start,         val_left, level+1,arena);
+			node->right = fill_tree(start+val_left,val_right,level+1,arena);
 		}
 		return node;
 	}
-	
-	// Method to recursively delete the nodes in the tree
-	void clean_tree(Node* node) {
-		if (node->left  != 0) { clean_tree(node->left ); }
-		if (node->right != 0) { clean_tree(node->right); }
-		delete node;
-	}
 
 	// Count all values right of a given node (the target)
 	unsigned count(unsigned target) {
@@ -0,0 +1,344 @@
+//////////////////////////////////
+//
+// == A reuse distance based GPU cache model
+// This file is part of a cache model for GPUs. The cache model is based on
+// reuse distance theory extended to work with GPUs. The cache model primarly
+// focusses on modelling NVIDIA's Fermi architecture.
+//
+// == More information on the GPU cache model
+// Article............A Detailed GPU Cache Model Based on Reuse Distance Theory
+// Authors............C. Nugteren et al.
+//
+// == Contents of this file
+// This particular file implements the golden-output regression harness. A fixed
+// corpus of small synthetic traces (see src/generator/generator.h) is modelled
+// with fixed seeds for a number of configurations. The full reuse distance
+// histograms of all cases and the breakdown of the misses are compared against
+// golden files in 'src/regress/golden'. The runtime of each entry is recorded
+// in a (local, not committed) timings file, such that the speed-up of a change
+// is reported together with its exactness. Run with 'make regress', or with
+// 'make regress ARGS=--update' to re-generate the golden files (and the timings)
+// after an intended change of the results.
+//
+// == File details
+// Filename...........src/regress/regress.cpp
+// Author.............Cedric Nugteren <www.cedricnugteren.nl>
+// Affiliation........Eindhoven University of Technology, The Netherlands
+// Last modified on...16-Oct-2026
+//
+//////////////////////////////////
+
+// Include the header files of the model and the trace generator
+#include "../model/model.h"
+#include "../generator/generator.h"
+
+// C++ headers
+#include <iomanip>
+#include <cstring>
+
+// System headers (to create the folders)
+#include <sys/stat.h>
+
+// Global settings for the directory structure (see src/model/io.cpp)
+extern std::string temp_dir;
+
+//////////////////////////////////
+// Regression settings
+//////////////////////////////////
+#define GOLDEN_DIR "src/regress/golden" // Folder holding the golden files
+#define TIMINGS_FILE "regress.times"     // File in the temporary folder holding the recorded runtimes
+
+//////////////////////////////////
+// Data-structure holding an entry of the regression corpus: a synthetic trace,
+// modelled with a number of hardware settings and model options
+//////////////////////////////////
+struct RegressionEntry {
+	std::string name;             // Name of the entry (and of its golden file)
+	std::string pattern;          // Access pattern of the synthetic trace
+	unsigned grid;                // Number of threadblocks
+	unsigned accesses;            // Number of loads per thread
+	unsigned bytes;               // Size of each access in bytes
+	unsigned long footprint;      // Size of the array in elements (gather only, 0 = the generator's default)
+	unsigned load_type;           // Type of the loads of the first array: 0 (global), 2 (texture) or 3 (constant)
+	std::string overrides;        // Hardware settings as KEY=value pairs (comma separated)
+	unsigned num_workers;         // Number of workers of the set-parallel mode (1 = serial)
+	double sample_rate;           // Fraction of cache-lines to sample (1.0 = exact model)
+	bool slots;                   // Whether or not to profile the accesses and misses per instruction slot
+	bool buffers;                 // Whether or not to attribute the accesses and misses to the arrays
+};
+
+//////////////////////////////////
+// The regression corpus
+//////////////////////////////////
+const RegressionEntry CORPUS[] = {
+	{ "stream",           "stream",  16, 16, 4,    0,  0, "",                                                  1, 1.0, false, false },
+	{ "strided",          "strided", 16, 16, 4,    0,  0, "",                                                  1, 1.0, false, false },
+	{ "matmul",           "matmul",  16, 32, 4,    0,  0, "",                                                  1, 1.0, false, false },
+	{ "matmul_48kb",      "matmul",  16, 32, 4,    0,  0, "CACHE_BYTES=49152,CACHE_WAYS=6",                    1, 1.0, false, false },
+	{ "stencil",          "stencil", 16, 20, 4,    0,  0, "",                                                  1, 1.0, false, false },
+	{ "stencil_8byte",    "stencil", 16, 20, 8,    0,  0, "MAPPING_TYPE=0",                                    1, 1.0, false, false },
+	{ "gather",           "gather",  16, 16, 4, 8192,  0, "",                                                  1, 1.0, false, false },
+	{ "gather_gto",       "gather",  16, 16, 4, 8192,  0, "WARP_SCHEDULER=1",                                  1, 1.0, false, false },
+	{ "stencil_twolevel", "stencil", 16, 20, 4,    0,  0, "WARP_SCHEDULER=2",                                  1, 1.0, false, false },
+	{ "matmul_parallel",  "matmul",  16, 32, 4,    0,  0, "",                                                  4, 1.0, false, false },
+	{ "stream_sampled",   "stream",  64, 16, 4,    0,  0, "",                                                  1, 0.25, false, false },
+	{ "matmul_mshr_5pct", "matmul",  32, 32, 4,    0,  0, "NUM_MSHR=8",                                        1, 0.05, false, false },
+	{ "matmul_l2",        "matmul",  16, 32, 4,    0,  0, "NUM_CORES=2,L2_BYTES=65536,L2_WAYS=8,L2_BANKS=2",   1, 1.0, false, false },
+	{ "stencil_wt",       "stencil", 16, 20, 4,    0,  0, "WRITE_POLICY=1",                                    1, 1.0, false, false },
+	{ "stencil_wb",       "stencil", 16, 20, 4,    0,  0, "WRITE_POLICY=2",                                    1, 1.0, false, false },
+	{ "stencil_wb_par",   "stencil", 16, 20, 4,    0,  0, "WRITE_POLICY=2",                                    4, 1.0, false, false },
+	{ "stencil_wb_mshr",  "stencil", 16, 20, 4,    0,  0, "WRITE_POLICY=2,NUM_MSHR=2",                         1, 1.0, false, false },
+	{ "strided_sector",   "strided", 16, 16, 4,    0,  0, "SECTOR_SIZE=32",                                    1, 1.0, false, false },
+	{ "sector_parallel",  "gather",   4, 16, 4, 4096,  0, "SECTOR_SIZE=32",                                    4, 1.0, false, false },
+	{ "matmul_texture",   "matmul",  16, 32, 4,    0,  2, "",                                                  1, 1.0, false, false },
+	{ "stencil_constant", "stencil", 16, 20, 4,    0,  3, "NUM_CORES=2,L2_BYTES=65536,L2_WAYS=8,L2_BANKS=2",   1, 1.0, false, false },
+	{ "matmul_slots",     "matmul",  16, 32, 4,    0,  2, "",                                                  1, 1.0, true,  false },
+	{ "stencil_buffers",  "stencil", 16, 20, 4,    0,  0, "WRITE_POLICY=2",                                    1, 1.0, false, true  },
+};
+const unsigned CORPUS_SIZE = sizeof(CORPUS)/sizeof(CORPUS[0]);
+
+//////////////////////////////////
+// Function to model an entry of the corpus and to write its results in the
+// format of the golden files: the misses and the sorted histograms of all cases
+//////////////////////////////////
+std::string run_entry(const RegressionEntry &entry,
+                      double &runtime) {
+
+	// Set the hardware settings and the model options
+	Settings hardware = default_settings();
+	std::istringstream overrides(entry.overrides);
+	std::string override;
+	while (std::getline(overrides, override, ',')) {
+		size_t split = override.find('=');
+		if (!set_setting(hardware, override.substr(0,split), atoi(override.substr(split+1).c_str()))) {
+			throw std::runtime_error("unknown setting '"+override+"'");
+		}
+	}
+	std::string error = finalise_settings(hardware);
+	if (error != "") {
+		throw std::runtime_error(error);
+	}
+	Options options = default_options();
+	options.verbose = false;
+	options.num_workers = entry.num_workers;
+	options.sample_rate = entry.sample_rate;
+	options.sample_threshold = (unsigned)(entry.sample_rate*SAMPLE_MODULUS);
+	options.slot_output = entry.slots;
+	
+	// Generate the trace and model it
+	TraceParameters parameters = default_trace_parameters();
+	parameters.pattern = entry.pattern;
+	parameters.grid = entry.grid;
+	parameters.accesses = entry.accesses;
+	parameters.bytes = entry.bytes;
+	if (entry.footprint > 0) { parameters.footprint = entry.footprint; }
+	parameters.load_type = entry.load_type;
+	std::string filename = temp_dir+"/regress.trc";
+	write_trace(parameters, filename);
+	if (entry.buffers) {
+		options.buffer_file = temp_dir+"/regress.buffers";
+		write_buffers(options.buffer_file);
+		options.buffer_map = std::make_shared<const BufferMap>(read_buffers(options.buffer_file));
+	}
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	Result result = model_trace(filename, hardware, options);
+	runtime = elapsed(start);
+	std::remove(filename.c_str());
+	if (entry.buffers) {
+		std::remove(options.buffer_file.c_str());
+	}
+	
+	// Write the breakdown of the misses
+	const Misses &misses = result.misses;
+	std::ostringstream golden;
+	golden << "accesses: " << misses.accesses << std::endl;
+	golden << "hits: " << misses.hits << std::endl;
+	golden << "misses(compulsory): " << misses.compulsory << std::endl;
+	golden << "misses(capacity): " << misses.capacity << std::endl;
+	golden << "misses(associativity): " << misses.associativity << std::endl;
+	golden << "misses(latency): " << misses.latency << std::endl;
+	golden << "misses(mshr): " << misses.mshr << std::endl;
+	golden << "misses(total): " << misses.total << std::endl;
+	golden << "misses(tot_associativity): " << misses.total_associativity << std::endl;
+	golden << "misses(tot_latency): " << misses.total_latency << std::endl;
+	golden << "misses(tot_mshr): " << misses.total_mshr << std::endl;
+	golden << "active_blocks: " << result.active_blocks << std::endl;
+	golden << "bandwidth: " << result.bandwidth.bytes << " bytes in " << result.bandwidth.cycles << " cycles (peak "
+	       << result.bandwidth.peak_bytes << " bytes in " << result.bandwidth.window << " cycles)" << std::endl;
+	if (hardware.write_policy != 0) {
+		const WriteStats &writes = result.writes;
+		golden << "stores: " << writes.stores << " (" << writes.store_hits << " hits, " << writes.store_misses << " misses)" << std::endl;
+		golden << "write_evictions: " << writes.write_evictions << std::endl;
+		golden << "write_backs: " << writes.write_backs << std::endl;
+		golden << "write_bytes: " << writes.write_bytes << std::endl;
+	}
+	if (hardware.sector_size > 0) {
+		golden << "sector_misses: " << result.sectors.sector_misses << std::endl;
+		golden << "fetched_sectors: " << result.sectors.fetched_sectors << std::endl;
+	}
+	if (misses.tex_accesses > 0) {
+		golden << "tex_accesses: " << misses.tex_accesses << " (" << misses.tex_misses << " misses)" << std::endl;
+	}
+	if (misses.const_accesses > 0) {
+		golden << "const_accesses: " << misses.const_accesses << " (" << misses.const_misses << " misses)" << std::endl;
+	}
+	if (hardware.l2_bytes > 0) {
+		golden << "l2_accesses: " << misses.l2_accesses << std::endl;
+		golden << "l2_hits: " << misses.l2_hits << std::endl;
+		golden << "l2_misses: " << misses.l2_misses << std::endl;
+	}
+	std::vector<ProfileStats> slot_stats = profile_statistics(result.slots, hardware);
+	for (unsigned s=0; s<slot_stats.size(); s++) {
+		golden << "slot_" << slot_stats[s].index << "(cache " << slot_stats[s].cache << "): " << slot_stats[s].accesses
+		       << " accesses (" << slot_stats[s].misses << " misses)" << std::endl;
+	}
+	std::vector<ProfileStats> buffer_stats = profile_statistics(result.buffers, hardware);
+	for (unsigned b=0; b<buffer_stats.size(); b++) {
+		golden << "buffer_" << buffer_stats[b].index << "(cache " << buffer_stats[b].cache << "): " << buffer_stats[b].accesses
+		       << " accesses (" << buffer_stats[b].misses << " misses)" << std::endl;
+	}
+	
+	// Write the histograms of all cases sorted by distance
+	for (unsigned c=0; c<result.distances.size(); c++) {
+		std::map<unsigned,unsigned> sorted(result.distances[c].begin(), result.distances[c].end());
+		golden << "case_" << c << ": " << sorted.size() << std::endl;
+		for (std::map<unsigned,unsigned>::iterator it=sorted.begin(); it!=sorted.end(); it++) {
+			golden << it->first << " " << it->second << std::endl;
+		}
+	}
+	return golden.str();
+}
+
+//////////////////////////////////
+// Helper function to split a text in lines
+//////////////////////////////////
+std::vector<std::string> split_lines(const std::string text) {
+	std::vector<std::string> lines;
+	std::istringstream stream(text);
+	std::string line;
+	while (std::getline(stream, line)) {
+		lines.push_back(line);
+	}
+	return lines;
+}
+
+//////////////////////////////////
+// Function to read the recorded runtimes (lines with a name and a runtime), and
+// to write them back
+//////////////////////////////////
+std::map<std::string,double> read_timings(const std::string filename) {
+	std::map<std::string,double> timings;
+	std::ifstream file(filename);
+	std::string name;
+	double runtime;
+	while (file >> name >> runtime) {
+		timings[name] = runtime;
+	}
+	return timings;
+}
+void write_timings(const std::string filename,
+                   const std::map<std::string,double> &timings) {
+	std::ofstream file(filename);
+	for (std::map<std::string,double>::const_iterator it=timings.begin(); it!=timings.end(); it++) {
+		file << it->first << " " << it->second << std::endl;
+	}
+}
+
+//////////////////////////////////
+// Main function of the regression harness
+//////////////////////////////////
+int main(int argc, char** argv) {
+	bool update = (argc >= 2 && std::string(argv[1]) == "--update");
+	mkdir(temp_dir.c_str(), 0755);
+	std::cout << SPLIT_STRING << std::endl;
+	std::cout << "### " << std::left << std::setw(20) << "Entry" << std::setw(10) << "Result" << std::right
+	          << std::setw(12) << "Time (s)" << std::setw(12) << "Golden (s)" << std::setw(10) << "Speed-up" << std::endl;
+	std::cout << SPLIT_STRING << std::endl;
+	
+	// Read the recorded runtimes (an entry without one records its current runtime)
+	std::string timings_file = temp_dir+"/"+TIMINGS_FILE;
+	std::map<std::string,double> timings = read_timings(timings_file);
+	
+	// Run all entries of the corpus
+	unsigned num_failed = 0;
+	double total_runtime = 0;
+	double total_golden_runtime = 0;
+	for (unsigned e=0; e<CORPUS_SIZE; e++) {
+		const RegressionEntry &entry = CORPUS[e];
+		std::string filename = std::string(GOLDEN_DIR)+"/"+entry.name+".golden";
+		double runtime = 0;
+		std::string status;
+		std::string difference;
+		std::string output;
+		try {
+			output = run_entry(entry, runtime);
+		}
+		catch (std::exception &error) {
+			status = "ERROR";
+			difference = error.what();
+		}
+		
+		// Read the golden file
+		std::stringstream contents;
+		std::ifstream golden_file(filename);
+		contents << golden_file.rdbuf();
+		if (status == "" && (update || timings.find(entry.name) == timings.end())) {
+			timings[entry.name] = runtime;
+		}
+		double golden_runtime = timings[entry.name];
+		
+		// Write the golden file (only if it changed) ...
+		if (status == "" && update) {
+			status = "PASS";
+			if (!golden_file || contents.str() != output) {
+				std::ofstream file(filename);
+				file << output;
+				status = (file) ? "UPDATED" : "ERROR";
+			}
+		}
+		
+		// ... or compare against the golden file
+		else if (status == "") {
+			if (!golden_file) {
+				status = "MISSING";
+				difference = "no golden file '"+filename+"' (run with --update)";
+			}
+			else {
+				std::vector<std::string> expected = split_lines(contents.str());
+				std::vector<std::string> actual = split_lines(output);
+				status = "PASS";
+				for (unsigned l=0; l<std::max(expected.size(),actual.size()); l++) {
+					std::string expected_line = (l < expected.size()) ? expected[l] : "<end of file>";
+					std::string actual_line = (l < actual.size()) ? actual[l] : "<end of output>";
+					if (expected_line != actual_line) {
+						status = "FAIL";
+						difference = "line "+std::to_string(l+1)+": expected '"+expected_line+"', got '"+actual_line+"'";
+						break;
+					}
+				}
+			}
+		}
+		if (status != "PASS" && status != "UPDATED") { num_failed++; }
+		total_runtime += runtime;
+		total_golden_runtime += golden_runtime;
+		
+		// Report the result of this entry
+		std::cout << "### " << std::left << std::setw(20) << entry.name << std::setw(10) << status << std::right
+		          << std::fixed << std::setprecision(4) << std::setw(12) << runtime << std::setw(12) << golden_runtime
+		          << std::setprecision(2) << std::setw(9) << ((runtime > 0) ? golden_runtime/runtime : 0) << "x" << std::endl;
+		std::cout.unsetf(std::ios::fixed);
+		if (difference != "") {
+			std::cout << "###    " << difference << std::endl;
+		}
+	}
+	
+	// Record the runtimes and report the summary
+	write_timings(timings_file, timings);
+	std::cout << SPLIT_STRING << std::endl;
+	std::cout << "### " << (CORPUS_SIZE-num_failed) << "/" << CORPUS_SIZE << " entries passed, total time "
+	          << total_runtime << "s (golden: " << total_golden_runtime << "s)" << std::endl;
+	std::cout << SPLIT_STRING << std::endl;
+	return (num_failed == 0) ? 0 : 1;
+}
+
+//////////////////////////////////
@@ -13,13 +13,20 @@
 // This file provides the Ocelot-based tracer. The tracer takes as input a CUDA
 // program emulated in Ocelot and outputs all memory accesses made per thread
 // (not in the real execution order - it is just an emulation). The output is
-// written to a file and can be limited to a certain amount of threads.
+// written to a file and can be limited to a certain amount of threads. Each
+// access is tagged with its type: 0 for a global load, 1 for a global store, 2
+// for a texture load and 3 for a constant load. The memory instructions of the
+// first thread are written to a second file (its type, PTX program counter and
+// PTX instruction per access), such that the model can name the instruction
+// slots. The memory allocations on the device at the start of the kernel are
+// written as a buffer map (a name, base address and size per allocation), such
+// that the model can attribute the accesses and misses to them.
 //
 // == File details
 // Filename...........src/tracer/tracer.cpp
 // Author.............Cedric Nugteren <www.cedricnugteren.nl>
 // Affiliation........Eindhoven University of Technology, The Netherlands
-// Last modified on...30-Oct-2013
+// Last modified on...16-Oct-2026
 //
 //////////////////////////////////
 
@@ -28,6 +35,7 @@
 #include <ocelot/trace/interface/TraceGenerator.h>
 #include <ocelot/trace/interface/TraceEvent.h>
 #include <ocelot/executive/interface/ExecutableKernel.h>
+#include <ocelot/executive/interface/Device.h>
 #include <ocelot/ir/interface/PTXInstruction.h>
 #include <ocelot/ir/interface/PTXOperand.h>
 
@@ -64,6 +72,7 @@ class TraceGenerator : public trace::TraceGenerator {
 	
 	// File streams
 	std::ofstream addrFile;
+	std::ofstream slotFile;
 	
 	// Name of the program
 	std::string name;
@@ -99,15 +108,25 @@ class TraceGenerator : public trace::TraceGenerator {
 		threads = 0;
 		finished = false;
 		initialised = false;
-		if (kernel_id < 10) {
-			addrFile.open("../../../output/"+name+"/"+name+"_0"+std::to_string(kernel_id)+".trc");
-		}
-		else {
-			addrFile.open("../../../output/"+name+"/"+name+"_"+std::to_string(kernel_id)+".trc");
-		}
+		std::string kernelname = name+((kernel_id < 10) ? "_0" : "_")+std::to_string(kernel_id);
+		addrFile.open("../../../output/"+name+"/"+kernelname+".trc");
+		slotFile.open("../../../output/"+name+"/"+kernelname+".slots");
+		writeBuffers(kernel, "../../../output/"+name+"/"+kernelname+".buffers");
 		kernel_id++;
 	}
 	
+	// Write the memory allocations of the device as a buffer map (global variables
+	// and allocations, e.g. by cudaMalloc, are named separately)
+	void writeBuffers(const executive::ExecutableKernel & kernel, std::string filename) {
+		std::ofstream bufferFile(filename);
+		executive::Device::MemoryAllocationVector allocations = kernel.device->getAllAllocations();
+		for (unsigned i=0; i<allocations.size(); i++) {
+			std::string prefix = (allocations[i]->global()) ? "global_" : "alloc_";
+			bufferFile << prefix << i << " 0x" << std::hex << (unsigned long)allocations[i]->pointer() << std::dec << " " << allocations[i]->size() << "\n";
+		}
+		bufferFile.close();
+	}
+	
 	// Finalise the data
 	void finalise() {
 		std::cout << "[Tracer] completed up to " << MAX_THREADS << " threads" << std::endl;
@@ -115,6 +134,9 @@ class TraceGenerator : public trace::TraceGenerator {
 		if( addrFile.is_open()) {
 			addrFile.close();
 		}
+		if (slotFile.is_open()) {
+			slotFile.close();
+		}
 	}
 	
 	// Ocelot event callback
@@ -138,12 +160,15 @@ class TraceGenerator : public trace::TraceGenerator {
 		// Only process the first MAX_THREADS threads
 		if (bid < MAX_THREADS/bdim) {
 		
-			// Found a global load/store
+			// Found a global load/store, a constant load or a texture load
 			if (((event.instruction->addressSpace == ir::PTXInstruction::Global) &&
 			    (event.instruction->opcode == ir::PTXInstruction::Ld || event.instruction->opcode == ir::PTXInstruction::St))
 			   ||
+			   ((event.instruction->addressSpace == ir::PTXInstruction::Const) &&
+			    (event.instruction->opcode == ir::PTXInstruction::Ld))
+			   ||
 			   (event.instruction->opcode == ir::PTXInstruction::Tex )) {
-
+			
 				// Loop over a warp's memory accesses
 				for (unsigned i=0; i<event.memory_addresses.size(); i++) {
 					while (event.active[i] == 0) { i++; }
@@ -157,10 +182,14 @@ class TraceGenerator : public trace::TraceGenerator {
 					unsigned vector = event.instruction->vec;
 					unsigned size = vector * ir::PTXOperand::bytes(datatype);
 					
-					// Found a global load or texture load
+					// Found a global, constant or texture load
+					unsigned type = 1;
 					if (event.instruction->opcode == ir::PTXInstruction::Ld || event.instruction->opcode == ir::PTXInstruction::Tex) {
+						type = 0;
+						if (event.instruction->opcode == ir::PTXInstruction::Tex) { type = 2; }
+						else if (event.instruction->addressSpace == ir::PTXInstruction::Const) { type = 3; }
 						loadCounter++;
-						addrFile << "" << gid << " 0 " << address << " " << size << "\n";
+						addrFile << "" << gid << " " << type << " " << address << " " << size << "\n";
 					}
 					
 					// Found a global store
@@ -169,6 +198,11 @@ class TraceGenerator : public trace::TraceGenerator {
 						addrFile << "" << gid << " 1 " << address << " " << size << "\n";
 					}
 					
+					// Name the instruction slot (first thread only)
+					if (gid == 0) {
+						slotFile << type << " " << event.PC << " " << event.instruction->toString() << "\n";
+					}
+					
 					// Next thread in the warp
 				}
 			}